@@ -0,0 +1,21 @@
+#ifndef CFS_SCHEDULER_H
+#define CFS_SCHEDULER_H
+
+#include "scheduler_interface.h"
+
+// Virtual runtime of one tick at nice 0; higher nice levels are charged more
+// per tick and so get a smaller share of the CPU
+#define CFS_TICK 1024
+
+// Highest nice level; each level gets about 25% less CPU than the one below
+#define CFS_MAX_NICE 9
+
+// Load weight of a nice level (clamped to 0..CFS_MAX_NICE); ready processes
+// share the CPU in proportion to their weights
+int cfs_weight(int nice);
+
+// Completely fair scheduler: runs the ready process with the least virtual
+// runtime, and switches once the running one is more than one tick ahead
+Scheduler* create_cfs_scheduler();
+
+#endif
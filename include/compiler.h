@@ -0,0 +1,65 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include "os.h"
+
+// Bytecode opcodes; operands are already resolved to slots, constants and IDs
+typedef enum {
+    OP_ASSIGN_INPUT,       // a = user input
+    OP_ASSIGN_READ_FILE,   // a = contents of the file named by b
+    OP_ASSIGN,             // a = b (variable, or the literal text if unset)
+    OP_PRINT,              // print a
+    OP_PRINT_FROM_TO,      // print the numbers from a to b
+    OP_WRITE_FILE,         // write b into the file named by a
+    OP_READ_FILE,          // read file a into the fileContent variable
+    OP_SEM_WAIT,           // semWait resource a
+    OP_SEM_SIGNAL,         // semSignal resource a
+    OP_INVALID             // line did not decode; running it terminates the process
+} opcode_t;
+
+// What an operand refers to
+typedef enum {
+    ARG_NONE,
+    ARG_SLOT,    // variable slot: word mem_low + slot of the process
+    ARG_CONST,   // index into the program's constant pool
+    ARG_IMM      // immediate integer (numbers, resource IDs)
+} arg_kind_t;
+
+struct bc_insn {
+    uint8_t op;
+    uint8_t kind_a, kind_b;
+    int32_t a, b;
+};
+
+struct program {
+    bc_insn_t *code;
+    int        n_code;
+    char     (*vars)[32];     // slot -> variable name
+    int        n_vars;
+    char     (*consts)[32];   // literals and names that are not variables
+    int        n_consts;
+    char      *text;          // source lines, each NUL-terminated
+    uint32_t  *line_off;      // line i starts at text + line_off[i]
+    uint32_t   text_len;
+    void      *image;         // mmap'd cache image backing all of the above, or NULL
+    size_t     image_len;
+};
+
+// Source text of instruction `i`, as it appeared in the program file
+static inline const char *program_line(const program_t *prog, int i) {
+    return prog->text + prog->line_off[i];
+}
+
+// Name given to the variable that readFile stores into
+#define FILE_CONTENT_VAR "fileContent"
+
+// Compile decoded instructions into bytecode; NULL if out of memory.
+// Resources are left as names until program_link() is called.
+program_t* compile_program(const instruction_t *insts, int n_insts);
+
+// Resolve resource names to semaphore IDs (IDs are only valid in this run)
+void program_link(program_t *prog);
+
+void program_free(program_t *prog);
+
+#endif // COMPILER_H
@@ -0,0 +1,15 @@
+#ifndef DEADLINE_SCHEDULER_H
+#define DEADLINE_SCHEDULER_H
+
+#include "scheduler_interface.h"
+
+// Earliest Deadline First: runs the ready process whose deadline comes
+// first, preempting the running one when an earlier deadline turns up.
+// Processes without a deadline run first come, first served after the rest.
+Scheduler* create_edf_scheduler();
+
+// Rate monotonic: fixed priorities, the shorter the period the higher.
+// Preemptive; aperiodic processes run after the periodic ones.
+Scheduler* create_rm_scheduler();
+
+#endif
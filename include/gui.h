@@ -2,6 +2,7 @@
 #define GUI_H
 
 #include <gtk/gtk.h>
+#include "io.h"
 
 // Global variables
 extern GtkWidget *log_view;
@@ -13,7 +14,6 @@ extern GtkWidget *memory_viewer;
 // Function declarations
 GtkWidget* init_gui(int argc, char *argv[]);
 void run_gui();
-void log_message(const char *message);
 void update_grid_display();
 void update_resource_panel(GtkWidget *panel);
 void update_memory_viewer(GtkWidget *viewer);
@@ -28,22 +28,7 @@ gboolean auto_run_callback(gpointer data);
 void cell_background_func(GtkTreeViewColumn *col, GtkCellRenderer *renderer, 
                          GtkTreeModel *model, GtkTreeIter *iter, gpointer user_data);
 
-// Function to get program input through GUI
-int get_program_input(int pid);
-
 // Function to check if input has been received
 int is_input_received();
 
-// Function to check if the input was text
-int is_program_text_input();
-
-// Function to get the text input
-const char* get_program_text_input();
-
-// Function to get file content through GUI
-char* get_file_content(const char* filename);
-
-// Function to write content to a file through GUI
-int write_file_content(const char* filename, const char* content);
-
 #endif // GUI_H 
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef IO_H
+#define IO_H
+
+// Where the simulator sends its log and gets program input and files from.
+// The GUI installs dialogs; the headless runner uses plain files.
+typedef struct {
+    void        (*log)(const char *message);  // program output, errors, reports
+    void        (*trace)(const char *message); // tick-by-tick trace; NULL = log
+    int         (*input)(int pid);           // numeric value (0 if text was entered)
+    int         (*input_is_text)(void);      // last input was text, not a number
+    const char *(*input_text)(void);
+    char       *(*read_file)(const char *filename);   // "" if unreadable
+    int         (*write_file)(const char *filename, const char *content);
+    void        (*resources_changed)(void);  // optional, may be NULL
+} io_backend_t;
+
+// Reads stdin and writes stdout and real files; the backend in use until replaced
+extern const io_backend_t io_stdio_backend;
+
+// Install `backend` (copied); NULL restores io_stdio_backend
+void io_set_backend(const io_backend_t *backend);
+
+// Function to log a message
+void log_message(const char *message);
+
+// Log what the simulator itself does each tick (clock, dispatch, fetch), as
+// opposed to what programs do; front ends may hide it
+void log_trace(const char *message);
+
+// Function to get program input
+int get_program_input(int pid);
+
+// Function to check if the input was text
+int is_program_text_input();
+
+// Function to get the text input
+const char* get_program_text_input();
+
+// Function to get file content
+char* get_file_content(const char* filename);
+
+// Function to write content to a file
+int write_file_content(const char* filename, const char* content);
+
+// Tell the front end that semaphore state changed
+void notify_resources_changed(void);
+
+#endif // IO_H
@@ -0,0 +1,42 @@
+#ifndef KEYED_HEAP_SCHEDULER_H
+#define KEYED_HEAP_SCHEDULER_H
+
+#include "scheduler_interface.h"
+#include "pcb_heap.h"
+
+// Common core of the schedulers that run the ready process with the
+// smallest key (SJF/SRT, EDF/RM, CFS, stride). The policy supplies the key
+// and what a tick on the CPU costs; queueing, preemption and stealing are
+// shared.
+typedef struct keyed_heap keyed_heap_t;
+
+typedef struct {
+    const char *name;  // for the log
+    // Key of a process joining the ready heap. May first move the process's
+    // own counter up to kh->floor so newcomers start level with the rest.
+    long (*key)(keyed_heap_t *kh, pcb_t *proc);
+    // 1 = the running process gives way in next as soon as a ready one has
+    // a strictly smaller key (its own is recomputed with key)
+    int preemptive;
+    // Shown after the keys in the preemption log ("left"); NULL = no keys
+    const char *key_unit;
+    // A tick was spent on the CPU, whether it ran on or blocked; may be NULL
+    void (*charge)(keyed_heap_t *kh, pcb_t *proc);
+    // Asked after charging: 1 = back into the heap, 0 = keep running.
+    // NULL keeps it running (next decides for preemptive policies).
+    int (*yields)(keyed_heap_t *kh, pcb_t *proc);
+    // The running process or the heap top changed; may be NULL
+    void (*settle)(keyed_heap_t *kh);
+} keyed_heap_policy_t;
+
+struct keyed_heap {
+    pcb_heap_t ready;   // keyed by policy->key
+    pcb_t* current;     // currently running process
+    long floor;         // lowest key in play, for policies that level newcomers
+    const keyed_heap_policy_t *policy;
+};
+
+// NULL if out of memory; the policy must outlive the scheduler
+Scheduler* create_keyed_heap_scheduler(int type, const keyed_heap_policy_t *policy);
+
+#endif
@@ -4,16 +4,41 @@
 //#include "os.h"
 
 // Each “word” maps a name → value string
-#define MAX_MEM_WORDS 60
+#define MEM_DEFAULT_WORDS 60   // pool size unless mem_set_size() picks another
+
+// How a word's value is stored; typed words are rendered to text lazily
+typedef enum {
+    MEM_TEXT,   // value holds the string
+    MEM_INT,    // ival holds the number
+    MEM_ENUM,   // ival indexes labels[]
+    MEM_ELAPSED // *clock - ival, worked out whenever the word is read
+} mem_type_t;
+
 typedef struct {
     char name[32];
-    char value[64];
+    char value[64];              // text, or cached rendering of a typed word
+    mem_type_t type;
+    int  ival;
+    const char *const *labels;   // MEM_ENUM only
+    const int *clock;            // MEM_ELAPSED only
+    int  stale;                  // typed value changed since last rendering
 } mem_word_t;
 
-// The memory pool
-extern mem_word_t memory_pool[MAX_MEM_WORDS];
+// The memory pool (mem_pool_size words, allocated at startup)
+extern mem_word_t *memory_pool;
+extern int mem_pool_size;
+
+// Free-space search used by mem_alloc
+typedef enum {
+    MEM_FIRST_FIT,   // lowest free run that fits (default)
+    MEM_BEST_FIT,    // smallest free run that fits
+    MEM_NEXT_FIT     // first fit, resuming after the previous allocation
+} mem_fit_t;
 
-// Initialize memory (set all entries empty)
+// (Re)allocate the pool with `n_words` words and clear it; 0 on success
+int  mem_set_size(int n_words);
+
+// Initialize memory (set all entries empty); allocates the default pool if needed
 void mem_init(void);
 
 // Allocate `n_words` consecutive words; return start index or −1 if fail
@@ -22,10 +47,28 @@ int  mem_alloc(int n_words);
 // Free a block (by marking words empty)
 void mem_free(int start, int n_words);
 
-// Utility: write a name/value into word `idx`
+// Choose the allocation policy; takes effect on the next mem_alloc
+void mem_set_fit_policy(mem_fit_t policy);
+
+// Utility: write a name/value into word `idx` (keeps the block's symbol index current)
 void mem_write(int idx, char *name,  char *value);
 
-// Utility: read value by name within a range
+// Utility: store a native integer / enum in word `idx` (no formatting)
+void mem_write_int(int idx, char *name, int value);
+void mem_write_enum(int idx, char *name, int value, const char *const *labels);
+
+// Utility: store a counter that reads as *clock - since (it keeps counting
+// without further writes)
+void mem_write_elapsed(int idx, char *name, int since, const int *clock);
+
+// Text form of word `idx`; typed words are formatted here, on demand
+const char *mem_text(int idx);
+
+// Utility: read value by name within a range; lookups inside one allocated
+// block go through that block's hashed symbol index instead of scanning
 char *mem_read(int low, int high,  char *name);
 
+// Like mem_read, but yields an integer word's native value; 0 if not found
+int  mem_read_int(int low, int high, char *name, int *out);
+
 #endif // MEMORY_H
@@ -4,6 +4,23 @@
 #include "scheduler_interface.h"
 //#include "os.h"
 
+#define MLFQ_DEFAULT_LEVELS 4
+#define MLFQ_MAX_LEVELS     64   // one bit per level in the occupancy bitmap
+
+typedef struct {
+    int levels;                    // priority levels, 1..MLFQ_MAX_LEVELS
+    int quanta[MLFQ_MAX_LEVELS];   // quantum per level; 0 = twice the level above (level 0: 1)
+    int boost_interval;            // ticks between boosts of everything to level 0; 0 = never
+} mlfq_config_t;
+
+// Uses the configuration set by mlfq_configure() (by default 4 levels with
+// quanta 1, 2, 4, 8 and no boost)
 Scheduler* create_mlfq_scheduler();
 
-#endif // MLFQ_SCHEDULER_H
\ No newline at end of file
+// NULL if the level count is out of range or memory runs out
+Scheduler* create_mlfq_scheduler_config(const mlfq_config_t *config);
+
+// Set the configuration used by create_mlfq_scheduler()
+void mlfq_configure(const mlfq_config_t *config);
+
+#endif // MLFQ_SCHEDULER_H
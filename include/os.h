@@ -7,8 +7,6 @@
 #include <string.h>
 #include "memory.h"
 
-#define MAX_PROCS     10
-#define MAX_MEM_WORDS 60
 #define MAX_VARS      3
 #define MAX_LINE_LEN  128
 
@@ -22,7 +20,8 @@ typedef enum {
     INST_WRITE_FILE,
     INST_READ_FILE,
     INST_SEM_WAIT,
-    INST_SEM_SIGNAL
+    INST_SEM_SIGNAL,
+    INST_INVALID     // line did not decode; running it terminates the process
 } inst_type_t;
 
 typedef struct {
@@ -31,6 +30,10 @@ typedef struct {
     char arg2[32];   // some instrs use two args
 } instruction_t;
 
+// Compiled program (see compiler.h)
+typedef struct bc_insn bc_insn_t;
+typedef struct program program_t;
+
 // Process Control Block
 typedef struct pcb{
     int       pid;
@@ -40,17 +43,47 @@ typedef struct pcb{
     int       mem_low;    // lower memory index
     int       mem_high;   // upper memory index
     int       pcb_index;  // inicates when pcb starts in memory (constant value)
-    int       time_in_queue; // time spent in the queue  
-    //instruction_t *code;  // pointer into loaded code array
+    int       time_in_queue; // time spent in the queue (while not queued; see pcb_wait_time)
+    int       enqueue_tick;  // sched_round when it joined a ready queue, -1 if not queued
+    program_t *prog;      // bytecode for the code segment, compiled once by add_process
+    int       code_base;  // first word of the (shared) code segment
+    int       code_len;   // instructions in the code segment
+    int       arrival_time; // clock tick it is admitted at (also mirrored in memory)
+    long      vruntime;   // CFS virtual runtime, weighted by nice
+    int       nice;       // CFS weight level, 0 = full weight, higher = less CPU
+    int       deadline;   // absolute tick to finish by, -1 = none
+    int       period;     // rate-monotonic period in ticks, 0 = aperiodic
+    int       deadline_missed;
+    int       tickets;    // proportional share (lottery, stride)
+    long      pass;       // stride pass value
+    int       cpu_ticks;  // ticks spent running an instruction
+    int       finish_tick; // clock tick it terminated in, -1 until then
+    int       dirty;      // memory mirror is behind (queued for the end-of-tick flush)
+    struct pcb *next_dirty;
+    int       slot;       // index in the process table
+    int       in_use;     // 0 once the slot is released
+    struct pcb *next_free;
 } pcb_t;
 
-void exec_print(pcb_t *proc, instruction_t *inst);
-void exec_assign(pcb_t *proc, instruction_t *inst);
-void exec_write_file(pcb_t *proc, instruction_t *inst);
-void exec_read_file(pcb_t *proc, instruction_t *inst);
-void exec_print_from_to(pcb_t *proc, instruction_t *inst);
+void exec_print(pcb_t *proc, const program_t *prog, const bc_insn_t *insn);
+void exec_assign(pcb_t *proc, const program_t *prog, const bc_insn_t *insn);
+void exec_write_file(pcb_t *proc, const program_t *prog, const bc_insn_t *insn);
+void exec_read_file(pcb_t *proc, const program_t *prog, const bc_insn_t *insn);
+void exec_print_from_to(pcb_t *proc, const program_t *prog, const bc_insn_t *insn);
+void exec_semaphore(pcb_t *proc, const program_t *prog, const bc_insn_t *insn);
+extern const char *const proc_state_names[];
 char * state_type_to_string(proc_state_t state);
 void update_pcb_in_memory(pcb_t *proc);
+void flush_pcb_updates(void);
+void discard_pcb_updates(void);
+
+// Ready-queue waits are counted in scheduling rounds (one scheduler->next()
+// per tick) and worked out from the enqueue stamp when read, so schedulers
+// never walk their queues to age what is in them
+extern int sched_round;
+void pcb_enter_queue(pcb_t *proc);   // joined a ready queue: wait starts at 0
+void pcb_leave_queue(pcb_t *proc);   // picked to run: wait reads 0 again
+int  pcb_wait_time(const pcb_t *proc);
 // void exec_semWait(pcb_t proc, instruction_t *inst, Scheduler* scheduler);
 // void exec_semSignal(instruction_t inst, Scheduler* scheduler);
 
@@ -6,4 +6,8 @@
 // Load program from path; returns number of instructions, or −1 on error
 instruction_t* parse_program(char *path) ;
 
+// Decode one program line into `inst` without allocating; 0 on success,
+// -1 (and inst->type == INST_INVALID) if the line is not an instruction
+int decode_instruction(const char *line, instruction_t *inst);
+
 #endif // PARSER_H
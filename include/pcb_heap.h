@@ -0,0 +1,58 @@
+#ifndef PCB_HEAP_H
+#define PCB_HEAP_H
+
+#include "os.h"
+
+// Growable binary min-heap of processes. Equal keys come out in the order
+// they went in, so ties are broken first come, first served.
+typedef struct {
+    long     key;
+    unsigned seq;    // insertion order, for ties
+    pcb_t   *proc;
+} pcb_heap_entry_t;
+
+typedef struct {
+    pcb_heap_entry_t *items;
+    int      size;
+    int      cap;
+    unsigned next_seq;
+} pcb_heap_t;
+
+// 0 on success, -1 if out of memory
+int ph_init(pcb_heap_t *h, int capacity);
+void ph_free(pcb_heap_t *h);
+
+// Insert with the given key; -1 if out of memory
+int ph_push(pcb_heap_t *h, long key, pcb_t *proc);
+
+// Remove the process with the smallest key; NULL if empty
+pcb_t* ph_pop(pcb_heap_t *h);
+
+// Remove every entry for `proc`; the rest keep their keys and tie order.
+// Returns how many went
+int ph_remove(pcb_heap_t *h, pcb_t *proc);
+
+// Remove the last leaf, some process other than the top unless it is the
+// only one (the rest stays a heap); NULL if empty
+static inline pcb_t* ph_pop_last(pcb_heap_t *h) {
+    return h->size ? h->items[--h->size].proc : NULL;
+}
+
+static inline int ph_size(const pcb_heap_t *h) {
+    return h->size;
+}
+
+static inline int ph_empty(const pcb_heap_t *h) {
+    return h->size == 0;
+}
+
+// Smallest key and its process (only valid when not empty)
+static inline long ph_top_key(const pcb_heap_t *h) {
+    return h->items[0].key;
+}
+
+static inline pcb_t* ph_top(const pcb_heap_t *h) {
+    return h->size ? h->items[0].proc : NULL;
+}
+
+#endif // PCB_HEAP_H
@@ -0,0 +1,41 @@
+#ifndef PROC_TABLE_H
+#define PROC_TABLE_H
+
+#include "os.h"
+
+// Process table. PCBs are handed out from fixed-size slabs that never move,
+// so the pointers held by schedulers and queues stay valid as the table
+// grows. Slots of reaped processes go on a free list and are reused first.
+#define PROC_SLAB_SIZE 64
+
+// PIDs are unique among the processes in the table and reused once a
+// process is released. They come from a bitmap and are indexed in a hash
+// table, so both handing one out and finding its PCB are O(1) on average.
+#define PID_MAX 4194304
+
+// A zeroed PCB in a free slot; NULL if out of memory
+pcb_t* proc_alloc(void);
+
+// Give the slot (and the PID) of a reaped process back
+void proc_release(pcb_t *proc);
+
+// Give `proc` a PID: `preferred` if it is free and in [0, PID_MAX), else the
+// lowest free one from 1. Returns the PID, -1 if out of memory or PIDs.
+int proc_assign_pid(pcb_t *proc, int preferred);
+
+// PCB of the process with `pid`; NULL if there is none
+pcb_t* proc_lookup(int pid);
+
+// Live processes in slot order, dead slots skipped:
+//   for (pcb_t *p = proc_first(); p; p = proc_next(p))
+// Releasing `p` inside the loop is allowed.
+pcb_t* proc_first(void);
+pcb_t* proc_next(const pcb_t *proc);
+
+// Number of live processes
+int proc_count(void);
+
+// Drop every process, free the slabs and forget every PID
+void proc_table_reset(void);
+
+#endif // PROC_TABLE_H
@@ -0,0 +1,14 @@
+#ifndef PROGRAM_CACHE_H
+#define PROGRAM_CACHE_H
+
+#include "compiler.h"
+
+// Directory for compiled program images; NULL (the default) disables the cache
+void program_cache_set_dir(const char *dir);
+
+// Read, decode, compile and link the program at `path`. With a cache
+// directory set, a compiled image whose source path, size and mtime still
+// match is mmap'd instead, and a fresh image is written after a compile.
+program_t* program_cache_load(const char *path);
+
+#endif // PROGRAM_CACHE_H
@@ -0,0 +1,20 @@
+#ifndef PROPORTIONAL_SCHEDULER_H
+#define PROPORTIONAL_SCHEDULER_H
+
+#include "scheduler_interface.h"
+
+// Stride of a process holding one ticket; a process with t tickets advances
+// its pass by STRIDE_ONE / t per tick it runs
+#define STRIDE_ONE (1L << 20)
+
+// Lottery: every tick a ticket is drawn among the ready processes and its
+// holder runs, so each gets the CPU in proportion to its tickets on average.
+// Uses the seed set by lottery_set_seed() (1 by default).
+Scheduler* create_lottery_scheduler();
+void lottery_set_seed(unsigned long seed);
+
+// Stride: deterministic proportional share, runs the ready process with the
+// lowest pass value
+Scheduler* create_stride_scheduler();
+
+#endif
@@ -4,7 +4,22 @@
 #include "scheduler_interface.h"
 //#include "os.h"
 
-// Pass in the desired quantum when creating
+// Adaptive mode: the quantum starts at RR_ADAPTIVE_START and is retuned
+// every RR_TUNE_WINDOW time slices. When three in four slices use up the
+// quantum (CPU-bound) and the CPU still switched processes more than once
+// every RR_SWITCH_TICKS ticks, it doubles to cut context switches. When at least
+// half end early (blocked on semWait or finished), it is set to the typical
+// burst to keep response time low. Either way a process at the back of the ready queue
+// waits at most about RR_TARGET_RESPONSE ticks.
+#define RR_ADAPTIVE         0
+#define RR_ADAPTIVE_START   2
+#define RR_MIN_QUANTUM      1
+#define RR_MAX_QUANTUM      16
+#define RR_TUNE_WINDOW      8
+#define RR_TARGET_RESPONSE  24
+#define RR_SWITCH_TICKS     4
+
+// Pass in the desired quantum when creating, or RR_ADAPTIVE
 Scheduler* create_rr_scheduler(int quantum);
 
 #endif
\ No newline at end of file
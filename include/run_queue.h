@@ -0,0 +1,44 @@
+#ifndef RUN_QUEUE_H
+#define RUN_QUEUE_H
+
+#include "os.h"
+
+// Growable FIFO of processes. The capacity is a power of two; head and tail
+// run freely and are masked on access, so the queue wraps around instead of
+// walking off the end, and doubles when full.
+typedef struct {
+    pcb_t  **slots;
+    unsigned mask;   // capacity - 1
+    unsigned head;   // next to pop
+    unsigned tail;   // next free slot
+} run_queue_t;
+
+// 0 on success, -1 if out of memory
+int rq_init(run_queue_t *q, unsigned capacity);
+void rq_free(run_queue_t *q);
+
+// Append at the back, or put back at the front; -1 if out of memory
+int rq_push(run_queue_t *q, pcb_t *proc);
+int rq_push_front(run_queue_t *q, pcb_t *proc);
+
+// Remove from the front, or the back; NULL if empty
+pcb_t* rq_pop(run_queue_t *q);
+pcb_t* rq_pop_back(run_queue_t *q);
+
+// Remove every entry for `proc`, keeping the rest in order; how many went
+int rq_remove(run_queue_t *q, pcb_t *proc);
+
+static inline int rq_size(const run_queue_t *q) {
+    return (int) (q->tail - q->head);
+}
+
+static inline int rq_empty(const run_queue_t *q) {
+    return q->head == q->tail;
+}
+
+// i-th process from the front (0 = next to run)
+static inline pcb_t* rq_at(const run_queue_t *q, int i) {
+    return q->slots[(q->head + i) & q->mask];
+}
+
+#endif // RUN_QUEUE_H
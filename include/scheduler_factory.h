@@ -0,0 +1,41 @@
+#ifndef SCHEDULER_FACTORY_H
+#define SCHEDULER_FACTORY_H
+
+#include "scheduler_interface.h"
+
+// Registry of scheduler factories by type. Types 1 to SCHEDULER_MAX are the
+// built-in SCHEDULER_* ones; schedulers registered later (or loaded from
+// modules) get the following types, in order.
+
+// Create a scheduler of a registered type (the quantum is only used by
+// those that take one, see scheduler_takes_quantum); NULL if the type is
+// unknown or memory runs out
+Scheduler* create_scheduler(int type, int quantum);
+
+// Register a factory under a new short name; its type, -1 if the name is
+// taken or memory runs out
+int scheduler_register(const char *short_name, const char *name, Scheduler* (*create)(void));
+
+// Load a shared object and register the scheduler it exports. A module
+// named NAME.so, libNAME.so or NAME_scheduler.so must export
+//   Scheduler* create_NAME_scheduler(void);
+//   const int scheduler_abi_version = SCHEDULER_ABI_VERSION;
+// and is registered as NAME. Its type, -1 on error (reported).
+int scheduler_load_module(const char *path);
+
+// Highest registered type; every type from 1 up to it exists
+int scheduler_count(void);
+
+// Whether the scheduler uses the quantum given to create_scheduler
+int scheduler_takes_quantum(int type);
+
+// Type for a short name ("fcfs", "rr", "mlfq", ...), -1 if unknown
+int scheduler_type_by_name(const char *name);
+
+// Display name ("FCFS", "Round Robin", ...), "Unknown" if there is none
+const char* scheduler_type_name(int type);
+
+// Short name as taken by scheduler_type_by_name
+const char* scheduler_short_name(int type);
+
+#endif // SCHEDULER_FACTORY_H
@@ -7,6 +7,19 @@
 #define SCHEDULER_FCFS 1
 #define SCHEDULER_RR   2
 #define SCHEDULER_MLFQ 3
+#define SCHEDULER_SJF  4
+#define SCHEDULER_SRT  5
+#define SCHEDULER_CFS  6
+#define SCHEDULER_EDF  7
+#define SCHEDULER_RM   8
+#define SCHEDULER_LOTTERY 9
+#define SCHEDULER_STRIDE  10
+#define SCHEDULER_MAX     10  // highest built-in type; modules come after (see scheduler_factory.h)
+
+// Layout of struct Scheduler and the contract of its hooks; bumped on any
+// change. Modules export it as `const int scheduler_abi_version` and are
+// refused when it differs.
+#define SCHEDULER_ABI_VERSION 2
 
 typedef struct Scheduler Scheduler;
 
@@ -19,10 +32,13 @@ struct Scheduler {
     pcb_t* (*queue)(Scheduler *self);  // get the next process in the queue
     int (*queue_size)(Scheduler *self); // get the size of the queue
     int (*queue_empty)(Scheduler *self); // check if the queue is empty
+    pcb_t* (*steal)(Scheduler *self);   // give up a waiting process (not the running one) to another CPU, or NULL (may be NULL)
+    int (*next_timer)(Scheduler *self); // sched_round at which next() has work even with nothing queued, -1 if never (may be NULL)
+    void (*purge)(Scheduler *self, pcb_t *proc); // drop every queue entry of a process that just finished (may be NULL: then nothing is reaped)
 
     // scheduler-specific data
     void *data;
-    int type;  // Type of scheduler (FCFS, RR, or MLFQ)
+    int type;  // Type of scheduler (SCHEDULER_*)
 };
 
 #endif // SCHEDULER_INTERFACE_H
\ No newline at end of file
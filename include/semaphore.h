@@ -13,9 +13,15 @@
 #define RESOURCE_USER_OUTPUT "userOutput"
 #define RESOURCE_FILE       "file"
 
+// IDs of the standard resources (sem_init_all registers them in this order)
+#define RESOURCE_USER_INPUT_ID  0
+#define RESOURCE_USER_OUTPUT_ID 1
+#define RESOURCE_FILE_ID        2
+
 typedef struct {
-    char name[16];
-    int value;             // 0 = locked, 1 = free
+    char *name;            // interned, never freed (IDs outlive resets)
+    int value;             // units free; 0 = locked
+    int count;             // units at reset (1 = mutex), see sem_set_count
     Node* queue;
     int queue_size;
     int initialized;       // Flag to indicate if semaphore is initialized
@@ -24,8 +30,9 @@ typedef struct {
 
 // Structure to hold resource status information for GUI
 typedef struct {
-    char name[16];
+    const char *name;      // owned by the semaphore table
     int value;
+    int count;
     int queue_size;
     int* waiting_pids;     // Array of PIDs waiting for this resource
     int current_holder;    // PID of process currently holding the resource (-1 if none)
@@ -34,11 +41,33 @@ typedef struct {
 // Initialize semaphores
 void sem_init_all(void);
 
+// Resource ID for `name`, registering it (as a mutex) if new; -1 if out of
+// memory. Names are hashed; the table grows as needed.
+int sem_lookup(char *name);
+
+// Give `name` `count` units (at least 1), registering it if new. Takes effect
+// now if it is not in use, else at the next sem_init_all. Its ID, -1 on error.
+int sem_set_count(const char *name, int count);
+
+// Read "name count" lines (# comments allowed) into sem_set_count; -1 if the
+// file cannot be read or a line is bad (reported)
+int sem_load_config(const char *path);
+
 // semWait/semSignal with PID and priority-aware unblock
 void sem_wait(char *name, pcb_t* pcb, Scheduler* schedule);
 void sem_signal(char *name, Scheduler* schedule);
 
-// Get status of all resources for GUI display
-void get_resource_status(resource_status_t* status_array, int* num_resources);
+// Same, by resource ID (used by compiled programs)
+void sem_wait_id(int id, pcb_t* pcb, Scheduler* schedule);
+void sem_signal_id(int id, Scheduler* schedule);
+
+// `pid` is being reaped: stop naming it as a holder, since the PID may be
+// handed to a new process. What it held stays locked.
+void sem_forget_holder(int pid);
+
+// Status of every resource, in ID order, for GUI display. Free it with
+// free_resource_status(); NULL if out of memory.
+resource_status_t* get_resource_status(int* num_resources);
+void free_resource_status(resource_status_t* status_array, int num_resources);
 
 #endif // SEMAPHORE_H
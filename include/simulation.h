@@ -0,0 +1,110 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "os.h"
+#include "scheduler_interface.h"
+#include "proc_table.h"
+
+// Simulation state, shared with the front ends. The processes are in the
+// process table (proc_table.h).
+extern Scheduler* scheduler;
+extern int clock_tick;
+extern int simulation_running;  // 0 = stopped, 1 = running
+
+// Simulated CPUs, each with its own scheduler and run queue. Every tick
+// each CPU runs one instruction; idle CPUs take waiting processes from the
+// busiest one. `scheduler` is CPU 0's.
+#define MAX_CPUS 64
+
+typedef struct {
+    int id;
+    Scheduler *sched;
+    pcb_t *current;   // process picked this tick, NULL if idle
+    int busy_ticks;
+    int idle_ticks;
+    int steals;       // processes taken from other CPUs
+} cpu_t;
+
+extern cpu_t cpus[MAX_CPUS];
+extern int num_cpus;
+extern int balance_scans;  // run queues looked at by idle CPUs looking for work
+
+// When nothing is runnable, jump the clock to the next arrival, deadline or
+// scheduler timer instead of stepping through the idle ticks one by one.
+// Logs and statistics are the same either way.
+extern int event_driven;
+extern int tick_limit;  // a run stops here; skips do not go past it
+
+// Deadline statistics, updated every tick
+#define LATENESS_BUCKETS 8
+extern int deadline_misses;        // processes that missed their deadline
+extern int deadline_miss_ticks;    // ticks spent by processes past their deadline
+extern int lateness_hist[LATENESS_BUCKETS];  // on time, 1, 2-3, 4-7, ..., 64+ ticks late
+
+// Recorded as processes terminate, so they cover reaped processes too
+extern int finished_processes;
+extern int finished_with_deadline;
+extern long total_turnaround;
+
+// Optional per-process parameters, 0 = not set
+typedef struct {
+    int deadline;  // ticks after arrival the process must finish within
+    int period;    // period in ticks (rate-monotonic priority); also the
+                   // deadline when none is given
+    int tickets;   // lottery/stride share, DEFAULT_TICKETS when not set
+    int nice;      // CFS weight level 0..CFS_MAX_NICE, 0 = full weight
+} proc_params_t;
+
+#define DEFAULT_TICKETS 100
+
+// Add a process running `filename` that arrives at `arrival_time`; `params`
+// may be NULL. 0 on success
+int sim_add_process(const char *filename, int arrival_time, const proc_params_t *params);
+
+// Same, with the file name, arrival time and optionally "deadline period
+// tickets nice" read from temp_input.txt (GUI)
+void add_process();
+
+// Admit processes whose arrival time has come
+void load_program();
+
+// Forget every process and the statistics about them (memory and
+// semaphores are reset separately)
+void sim_reset_processes();
+
+// NULL-terminated lists of the ready and blocked processes in the process
+// table, refreshed by get_ready_queue() and get_blocked_queue()
+extern pcb_t** ready_queue;
+extern pcb_t** blocked_queue;
+void get_ready_queue();
+void get_blocked_queue();
+
+// Run one clock tick
+void simulation_step();
+
+// Print each process's share of the CPU so far next to the share its
+// tickets (or, under CFS, its nice level) ask for
+void sim_report_shares();
+
+// Ask for a scheduler on stdin
+void choose_scheduler();
+
+// Number of CPUs, 1 to MAX_CPUS; takes effect at the next sim_set_scheduler.
+// -1 if out of range
+int sim_set_cpus(int n);
+
+// Give every CPU a fresh scheduler of a SCHEDULER_* type (see
+// scheduler_factory.h), replacing the current ones; -1 if it cannot be created
+int sim_set_scheduler(int type, int quantum);
+void sim_destroy_scheduler();
+
+// Print per-CPU utilisation and load-balancing counts (more than one CPU)
+void sim_report_cpus();
+
+// Consume simulator options (--mem-words, --fit, --program-cache,
+// --mlfq-levels/--mlfq-quanta/--mlfq-boost, --lottery-seed, --cpus,
+// --event-driven, --scheduler-module, --resources) from argv, leaving the rest for
+// the front end
+void sim_parse_options(int *argc, char *argv[]);
+
+#endif // SIMULATION_H
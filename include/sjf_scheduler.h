@@ -0,0 +1,14 @@
+#ifndef SJF_SCHEDULER_H
+#define SJF_SCHEDULER_H
+
+#include "scheduler_interface.h"
+
+// Shortest Job First: runs the ready process with the fewest instructions
+// left, to completion or until it blocks
+Scheduler* create_sjf_scheduler();
+
+// Shortest Remaining Time: preemptive SJF, the running process gives way as
+// soon as a ready process has strictly fewer instructions left
+Scheduler* create_srt_scheduler();
+
+#endif
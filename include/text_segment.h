@@ -0,0 +1,24 @@
+#ifndef TEXT_SEGMENT_H
+#define TEXT_SEGMENT_H
+
+#include "compiler.h"
+
+// Shared code segment of a program: its instruction lines live once in
+// memory at [base, base + prog->n_code), whatever the number of processes
+typedef struct {
+    program_t *prog;
+    int        base;
+} text_segment_t;
+
+// Attach to the segment for `path`, loading it into memory on first use.
+// Returns 0, -1 if the file cannot be read, or -2 if memory is full.
+int text_segment_attach(const char *path, text_segment_t *seg);
+
+// Drop one reference; the last one frees the memory and the program
+void text_segment_detach(const program_t *prog);
+
+// Forget every segment and free its program (the memory holding them has
+// been wiped, and no process may still run them)
+void text_segment_reset(void);
+
+#endif // TEXT_SEGMENT_H
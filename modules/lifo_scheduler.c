@@ -0,0 +1,102 @@
+// Example scheduler module: last come, first served. Build with
+// `make modules` and load with --scheduler-module=modules/lifo_scheduler.so,
+// then pick it as --scheduler=lifo (or from the GUI list).
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/scheduler_interface.h"
+#include "../include/run_queue.h"
+
+// Checked by the loader against the simulator's own
+const int scheduler_abi_version = SCHEDULER_ABI_VERSION;
+
+typedef struct {
+    run_queue_t ready;  // newest at the back
+} lifo_data_t;
+
+static void enqueue_lifo(Scheduler *self, pcb_t *proc) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    if (rq_push(&q->ready, proc) < 0) {
+        printf("Error: out of memory queueing process %d\n", proc->pid);
+        return;
+    }
+    proc->state = READY;
+    pcb_enter_queue(proc); // Wait time counts from now
+}
+
+static pcb_t* next_lifo(Scheduler *self) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    pcb_t *proc = rq_pop_back(&q->ready);
+    if (proc) pcb_leave_queue(proc); // Reset time in queue for the running process
+    return proc;
+}
+
+static void preempt_lifo(Scheduler *self, pcb_t *proc) {
+    // Back on top, unless something newer arrives first
+    proc->state = READY;
+    update_pcb_in_memory(proc); // Update PCB in memory
+    enqueue_lifo(self, proc);
+}
+
+static void destroy_lifo(Scheduler *self) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    rq_free(&q->ready);
+    free(q);
+    free(self);
+}
+
+static void dequeue_lifo(Scheduler *self, pcb_t *proc) {
+    // Only the running process blocks, and next_lifo already popped it
+    (void) self;
+    (void) proc;
+}
+
+static pcb_t* queue_lifo(Scheduler *self) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    return rq_empty(&q->ready) ? NULL : rq_at(&q->ready, rq_size(&q->ready) - 1);
+}
+
+static int queue_size_lifo(Scheduler *self) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    return rq_size(&q->ready);
+}
+
+static int queue_empty_lifo(Scheduler *self) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    return rq_empty(&q->ready);
+}
+
+static pcb_t* steal_lifo(Scheduler *self) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    // Give away the oldest, which would wait longest here; the running
+    // process is never in the queue
+    return rq_pop(&q->ready);
+}
+
+static void purge_lifo(Scheduler *self, pcb_t *proc) {
+    lifo_data_t *q = (lifo_data_t*) self->data;
+    rq_remove(&q->ready, proc);
+}
+
+Scheduler* create_lifo_scheduler(void) {
+    Scheduler *s = calloc(1, sizeof(Scheduler));  // hooks left out stay NULL
+    lifo_data_t *q = calloc(1, sizeof(lifo_data_t));
+    if (!s || !q || rq_init(&q->ready, 0) < 0) {
+        free(q);
+        free(s);
+        return NULL;
+    }
+    s->data = q;
+    s->type = 0;  // set by the registry
+    s->scheduler_enqueue = enqueue_lifo;
+    s->next = next_lifo;
+    s->preempt = preempt_lifo;
+    s->destroy = destroy_lifo;
+    s->scheduler_dequeue = dequeue_lifo;
+    s->queue = queue_lifo;
+    s->queue_size = queue_size_lifo;
+    s->queue_empty = queue_empty_lifo;
+    s->steal = steal_lifo;
+    s->next_timer = NULL;
+    s->purge = purge_lifo;
+    return s;
+}
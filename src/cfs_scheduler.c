@@ -0,0 +1,55 @@
+// src/cfs_scheduler.c
+#include "../include/cfs_scheduler.h"
+#include "../include/keyed_heap_scheduler.h"
+
+// Load weight per nice level, the same curve as Linux nice 0..9
+static const int nice_weight[CFS_MAX_NICE + 1] = { 1024, 820, 655, 526, 423, 335, 272, 215, 172, 137 };
+
+int cfs_weight(int nice) {
+    if (nice < 0) nice = 0;
+    if (nice > CFS_MAX_NICE) nice = CFS_MAX_NICE;
+    return nice_weight[nice];
+}
+
+// Virtual runtime charged for one tick on the CPU
+static long tick_cost(const pcb_t *proc) {
+    return (long) CFS_TICK * nice_weight[0] / cfs_weight(proc->nice);
+}
+
+// kh->floor is min_vruntime: it never goes backwards
+static void update_min_vruntime(keyed_heap_t *kh) {
+    long min = kh->current ? kh->current->vruntime : 0;
+    if (!ph_empty(&kh->ready) && (!kh->current || ph_top_key(&kh->ready) < min)) {
+        min = ph_top_key(&kh->ready);
+    }
+    if (min > kh->floor) kh->floor = min;
+}
+
+static long vruntime_key(keyed_heap_t *kh, pcb_t *proc) {
+    // New and woken processes start level with the rest instead of
+    // catching up on the time they were away
+    if (proc->vruntime < kh->floor) proc->vruntime = kh->floor;
+    return proc->vruntime;
+}
+
+static void charge_cfs(keyed_heap_t *kh, pcb_t *proc) {
+    (void) kh;
+    proc->vruntime += tick_cost(proc);
+}
+
+// Someone else is now owed the CPU
+static int yields_cfs(keyed_heap_t *kh, pcb_t *proc) {
+    return !ph_empty(&kh->ready) && proc->vruntime > ph_top_key(&kh->ready) + CFS_TICK;
+}
+
+static const keyed_heap_policy_t cfs_policy = {
+    .name = "CFS",
+    .key = vruntime_key,
+    .charge = charge_cfs,
+    .yields = yields_cfs,
+    .settle = update_min_vruntime,
+};
+
+Scheduler* create_cfs_scheduler() {
+    return create_keyed_heap_scheduler(SCHEDULER_CFS, &cfs_policy);
+}
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "../include/compiler.h"
+#include "../include/semaphore.h"
+
+// Slot of variable `name`, or -1 if the program never assigns it
+static int find_var(const program_t *prog, const char *name) {
+    for (int i = 0; i < prog->n_vars; i++) {
+        if (strcmp(prog->vars[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+// Variables get slots in the order the program first assigns them, which
+// is the order the interpreter used to fill the variable words in
+static int intern_var(program_t *prog, const char *name) {
+    int slot = find_var(prog, name);
+    if (slot >= 0) return slot;
+    slot = prog->n_vars++;
+    strncpy(prog->vars[slot], name, sizeof(prog->vars[slot]) - 1);
+    return slot;
+}
+
+static int intern_const(program_t *prog, const char *text) {
+    for (int i = 0; i < prog->n_consts; i++) {
+        if (strcmp(prog->consts[i], text) == 0) return i;
+    }
+    int idx = prog->n_consts++;
+    strncpy(prog->consts[idx], text, sizeof(prog->consts[idx]) - 1);
+    return idx;
+}
+
+// A name read by an instruction: its slot if assigned anywhere, else a constant
+static void operand_name(program_t *prog, const char *name, uint8_t *kind, int32_t *val) {
+    int slot = find_var(prog, name);
+    if (slot >= 0) {
+        *kind = ARG_SLOT;
+        *val = slot;
+    } else {
+        *kind = ARG_CONST;
+        *val = intern_const(prog, name);
+    }
+}
+
+// Operand of printFromTo: a variable, or a number folded at compile time
+static void operand_number(program_t *prog, const char *name, uint8_t *kind, int32_t *val) {
+    int slot = find_var(prog, name);
+    if (slot >= 0) {
+        *kind = ARG_SLOT;
+        *val = slot;
+    } else {
+        *kind = ARG_IMM;
+        *val = atoi(name);
+    }
+}
+
+program_t* compile_program(const instruction_t *insts, int n_insts) {
+    program_t *prog = calloc(1, sizeof(program_t));
+    if (!prog) return NULL;
+
+    // At most two names per instruction can be variables or constants
+    int cap = n_insts > 0 ? 2 * n_insts : 1;
+    prog->code = calloc(n_insts > 0 ? n_insts : 1, sizeof(bc_insn_t));
+    prog->vars = calloc(cap, sizeof(*prog->vars));
+    prog->consts = calloc(cap, sizeof(*prog->consts));
+    if (!prog->code || !prog->vars || !prog->consts) {
+        program_free(prog);
+        return NULL;
+    }
+    prog->n_code = n_insts;
+
+    // Pass 1: give every assigned variable its slot
+    for (int i = 0; i < n_insts; i++) {
+        if (insts[i].type == INST_ASSIGN) intern_var(prog, insts[i].arg1);
+        else if (insts[i].type == INST_READ_FILE) intern_var(prog, FILE_CONTENT_VAR);
+    }
+
+    // Pass 2: emit bytecode with every name resolved
+    for (int i = 0; i < n_insts; i++) {
+        const instruction_t *in = &insts[i];
+        bc_insn_t *out = &prog->code[i];
+
+        switch (in->type) {
+            case INST_ASSIGN:
+                out->kind_a = ARG_SLOT;
+                out->a = find_var(prog, in->arg1);
+                if (strcmp(in->arg2, "input") == 0) {
+                    out->op = OP_ASSIGN_INPUT;
+                } else if (strncmp(in->arg2, "readFile", 8) == 0) {
+                    // Nested instruction: readFile <variable holding the name>
+                    char filename_var[32] = "";
+                    if (in->arg2[8] != '\0') sscanf(in->arg2 + 9, "%31s", filename_var);
+                    out->op = OP_ASSIGN_READ_FILE;
+                    operand_name(prog, filename_var, &out->kind_b, &out->b);
+                } else {
+                    out->op = OP_ASSIGN;
+                    operand_name(prog, in->arg2, &out->kind_b, &out->b);
+                }
+                break;
+            case INST_PRINT:
+                out->op = OP_PRINT;
+                operand_name(prog, in->arg1, &out->kind_a, &out->a);
+                break;
+            case INST_PRINT_FROM_TO:
+                out->op = OP_PRINT_FROM_TO;
+                operand_number(prog, in->arg1, &out->kind_a, &out->a);
+                operand_number(prog, in->arg2, &out->kind_b, &out->b);
+                break;
+            case INST_WRITE_FILE:
+                out->op = OP_WRITE_FILE;
+                operand_name(prog, in->arg1, &out->kind_a, &out->a);
+                operand_name(prog, in->arg2, &out->kind_b, &out->b);
+                break;
+            case INST_READ_FILE:
+                out->op = OP_READ_FILE;
+                out->kind_a = ARG_CONST;
+                out->a = intern_const(prog, in->arg1);
+                out->kind_b = ARG_SLOT;
+                out->b = find_var(prog, FILE_CONTENT_VAR);
+                break;
+            case INST_SEM_WAIT:
+            case INST_SEM_SIGNAL:
+                out->op = in->type == INST_SEM_WAIT ? OP_SEM_WAIT : OP_SEM_SIGNAL;
+                out->kind_a = ARG_CONST;   // resolved by program_link
+                out->a = intern_const(prog, in->arg1);
+                break;
+            default:
+                out->op = OP_INVALID;
+                break;
+        }
+    }
+    return prog;
+}
+
+void program_link(program_t *prog) {
+    for (int i = 0; i < prog->n_code; i++) {
+        bc_insn_t *insn = &prog->code[i];
+        if ((insn->op == OP_SEM_WAIT || insn->op == OP_SEM_SIGNAL) && insn->kind_a == ARG_CONST) {
+            int id = sem_lookup(prog->consts[insn->a]);
+            if (id >= 0) {   // otherwise out of memory; reported when executed
+                insn->kind_a = ARG_IMM;
+                insn->a = id;
+            }
+        }
+    }
+}
+
+void program_free(program_t *prog) {
+    if (!prog) return;
+    if (prog->image) {
+        munmap(prog->image, prog->image_len);
+    } else {
+        free(prog->code);
+        free(prog->vars);
+        free(prog->consts);
+        free(prog->text);
+        free(prog->line_off);
+    }
+    free(prog);
+}
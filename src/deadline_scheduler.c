@@ -0,0 +1,35 @@
+// src/deadline_scheduler.c
+#include <limits.h>
+#include "../include/deadline_scheduler.h"
+#include "../include/keyed_heap_scheduler.h"
+
+static long edf_key(keyed_heap_t *kh, pcb_t *proc) {
+    (void) kh;
+    return proc->deadline >= 0 ? proc->deadline : LONG_MAX;
+}
+
+static long rm_key(keyed_heap_t *kh, pcb_t *proc) {
+    (void) kh;
+    return proc->period > 0 ? proc->period : LONG_MAX;
+}
+
+// A more urgent process that arrived or woke up takes over
+static const keyed_heap_policy_t edf_policy = {
+    .name = "EDF",
+    .key = edf_key,
+    .preemptive = 1,
+};
+
+static const keyed_heap_policy_t rm_policy = {
+    .name = "RM",
+    .key = rm_key,
+    .preemptive = 1,
+};
+
+Scheduler* create_edf_scheduler() {
+    return create_keyed_heap_scheduler(SCHEDULER_EDF, &edf_policy);
+}
+
+Scheduler* create_rm_scheduler() {
+    return create_keyed_heap_scheduler(SCHEDULER_RM, &rm_policy);
+}
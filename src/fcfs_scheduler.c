@@ -1,69 +1,76 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include "../include/fcfs_scheduler.h"
-
-#define MAX_QUEUE 100
+#include "../include/run_queue.h"
 
 typedef struct {
-    pcb_t* queue[MAX_QUEUE];
-    int head, tail;
+    run_queue_t ready;
 } fcfs_data_t;
 
 static void enqueue_fcfs(Scheduler *self, pcb_t *proc) {
     fcfs_data_t *q = (fcfs_data_t*) self->data;
-    q->queue[q->tail++] = proc;
+    if (rq_push(&q->ready, proc) < 0) {
+        printf("Error: out of memory queueing process %d\n", proc->pid);
+        return;
+    }
     proc->state = READY;
-    proc->time_in_queue = 0; // Reset time in queue
-    update_pcb_in_memory(proc); // Update PCB in memory
+    pcb_enter_queue(proc); // Wait time counts from now
 }
 
 static pcb_t* next_fcfs(Scheduler *self) {
     fcfs_data_t *q = (fcfs_data_t*) self->data;
-    if (q->head < q->tail){
-        // Increment time for all processes in the queue
-        for (int i = q->head + 1; i < q->tail; i++) {
-            q->queue[i]->time_in_queue++;
-            update_pcb_in_memory(q->queue[i]); // Update PCB in memory
-        }
-        // Update the time for the process at the head
-        q->queue[q->head]->time_in_queue= 0; // Reset time in queue for the running process
-        update_pcb_in_memory(q->queue[q->head]); // Update PCB in memory
-        return q->queue[q->head++];
+    if (!rq_empty(&q->ready)){
+        // Waiting processes age by themselves (see pcb_wait_time)
+        pcb_t *head = rq_pop(&q->ready);
+        pcb_leave_queue(head); // Reset time in queue for the running process
+        return head;
     }
     return NULL;
 }
 
 static void preempt_fcfs(Scheduler *self, pcb_t *proc) {
     fcfs_data_t *q = (fcfs_data_t*) self->data;
-    q->queue[(q->head)-1] = proc;
-    q->head--;
+    // Still the front of the queue: put it back there. Like the original
+    // head of the queue, it does not age until it is picked again.
+    rq_push_front(&q->ready, proc);
 }
 
 static void destroy_fcfs(Scheduler *self) {
+    fcfs_data_t *q = (fcfs_data_t*) self->data;
+    rq_free(&q->ready);
     free(self->data);
     free(self);
 }
 static void dequeue_fcfs(Scheduler* sched, pcb_t* proc) {
-    fcfs_data_t *q = (fcfs_data_t*) sched->data;
-    // Only remove if it's the currently scheduled process (at the head)
-    // This is called when the process blocks itself (e.g., semWait)
-    if (q->head < q->tail && q->queue[q->head-1] == proc) {
-         // Effectively, the 'next' call already advanced head, so we don't need to do much here.
-         // If 'next' hadn't been called yet, we'd do q->head++.
-    }
+    // Only the currently scheduled process blocks itself (e.g., semWait),
+    // and 'next' already popped it off the queue, so there is nothing to do
+    (void) sched;
+    (void) proc;
 }
 static pcb_t* queue_fcfs(Scheduler *self) {
     fcfs_data_t *q = (fcfs_data_t*) self->data;
-    if (q->head < q->tail)
-        return q->queue[q->head];
+    if (!rq_empty(&q->ready))
+        return rq_at(&q->ready, 0);
     return NULL;
 }
 static int queue_size_fcfs(Scheduler *self) {
     fcfs_data_t *q = (fcfs_data_t*) self->data;
-    return q->tail - q->head;
+    return rq_size(&q->ready);
 }
 static int queue_empty_fcfs(Scheduler *self) {
     fcfs_data_t *q = (fcfs_data_t*) self->data;
-    return q->head == q->tail;
+    return rq_empty(&q->ready);
+}
+static pcb_t* steal_fcfs(Scheduler *self) {
+    fcfs_data_t *q = (fcfs_data_t*) self->data;
+    // The running process sits at the front (see preempt_fcfs); take from the back
+    if (rq_empty(&q->ready) || rq_at(&q->ready, rq_size(&q->ready) - 1)->state == RUNNING)
+        return NULL;
+    return rq_pop_back(&q->ready);
+}
+static void purge_fcfs(Scheduler *self, pcb_t *proc) {
+    fcfs_data_t *q = (fcfs_data_t*) self->data;
+    rq_remove(&q->ready, proc);
 }
 
 
@@ -71,11 +78,13 @@ Scheduler* create_fcfs_scheduler() {
     Scheduler *s = malloc(sizeof(Scheduler));
     if (!s) return NULL;
     
-    s->data = calloc(1, sizeof(fcfs_data_t));
-    if (!s->data) {
+    fcfs_data_t *q = calloc(1, sizeof(fcfs_data_t));
+    if (!q || rq_init(&q->ready, 0) < 0) {
+        free(q);
         free(s);
         return NULL;
     }
+    s->data = q;
     
     s->type = SCHEDULER_FCFS;
     s->scheduler_enqueue = enqueue_fcfs;
@@ -86,6 +95,9 @@ Scheduler* create_fcfs_scheduler() {
     s->queue = queue_fcfs;
     s->queue_size = queue_size_fcfs;
     s->queue_empty= queue_empty_fcfs;
+    s->steal = steal_fcfs;
+    s->next_timer = NULL;
+    s->purge = purge_fcfs;
     
     return s;
 }
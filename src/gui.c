@@ -4,20 +4,17 @@
 #include "../include/os.h"
 #include "../include/memory.h"
 #include "../include/parser.h"
+#include "../include/text_segment.h"
+#include "../include/io.h"
 #include "../include/semaphore.h"
 #include "../include/scheduler_interface.h"
-#include "../include/fcfs_scheduler.h"
+#include "../include/scheduler_factory.h"
 #include "../include/round_robin_scheduler.h"
-#include "../include/mlfq_scheduler.h"
+#include "../include/simulation.h"
 
-#define MAX_SEMAPHORES 3  // Define the maximum number of semaphores
 #define GRID_ROWS 20  // Increased rows to show more information
 #define GRID_COLS 4
 #define MAX_HISTORY 100  // Maximum number of history entries to keep
-#define MEMORY_SIZE 60
-
-// External declarations for memory
-extern mem_word_t memory_pool[MAX_MEM_WORDS];
 
 // Structure to store process state history
 typedef struct {
@@ -30,8 +27,6 @@ typedef struct {
 
 // External variables
 extern Scheduler* scheduler;
-extern pcb_t processes[3];
-extern int num_processes;
 extern int clock_tick;
 extern int simulation_running;
 extern int auto_mode;
@@ -47,7 +42,6 @@ extern void simulation_step();
 extern void add_process();
 extern void sem_init_all();
 extern void mem_init();
-extern void get_resource_status(resource_status_t* status_array, int* num_resources);
 void update_grid_display();  // Added function declaration
 void cell_background_func(GtkTreeViewColumn *col, GtkCellRenderer *renderer, 
                          GtkTreeModel *model, GtkTreeIter *iter, gpointer user_data);
@@ -78,7 +72,26 @@ static int input_received = 0;
 static char program_text_input[256] = "";
 static int is_text_input = 0;
 
-void log_message(const char *message) {
+// Program I/O goes through modal dialogs
+static void gui_log_message(const char *message);
+static int gui_program_input(int pid);
+static int gui_input_is_text(void);
+static const char* gui_input_text(void);
+static char* gui_read_file(const char* filename);
+static int gui_write_file(const char* filename, const char* content);
+static void gui_resources_changed(void);
+
+static const io_backend_t gui_io = {
+    .log = gui_log_message,
+    .input = gui_program_input,
+    .input_is_text = gui_input_is_text,
+    .input_text = gui_input_text,
+    .read_file = gui_read_file,
+    .write_file = gui_write_file,
+    .resources_changed = gui_resources_changed
+};
+
+static void gui_log_message(const char *message) {
     GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(log_view));
     GtkTextIter end;
     gtk_text_buffer_get_end_iter(buffer, &end);
@@ -108,15 +121,16 @@ void on_choose_scheduler(GtkButton *button, gpointer user_data) {
     
     // Create the dropdown menu
     GtkWidget *combo = gtk_combo_box_text_new();
-    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), "FCFS");
-    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), "Round Robin");
-    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), "MLFQ");
+    // Entry i is scheduler type i + 1, built-in ones first, then modules
+    for (int type = 1; type <= scheduler_count(); type++) {
+        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), scheduler_type_name(type));
+    }
     gtk_combo_box_set_active(GTK_COMBO_BOX(combo), 0); // Default to FCFS
     gtk_box_pack_start(GTK_BOX(vbox), combo, FALSE, FALSE, 5);
     
     // Add quantum entry for Round Robin
     GtkWidget *quantum_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
-    GtkWidget *quantum_label = gtk_label_new("Quantum (for RR):");
+    GtkWidget *quantum_label = gtk_label_new("Quantum (for RR, 0 = adaptive):");
     GtkWidget *quantum_entry = gtk_entry_new();
     gtk_entry_set_text(GTK_ENTRY(quantum_entry), "2"); // Default value
     
@@ -124,6 +138,17 @@ void on_choose_scheduler(GtkButton *button, gpointer user_data) {
     gtk_box_pack_start(GTK_BOX(quantum_box), quantum_entry, TRUE, TRUE, 0);
     gtk_box_pack_start(GTK_BOX(vbox), quantum_box, FALSE, FALSE, 5);
     
+    // Number of simulated CPUs
+    GtkWidget *cpus_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    GtkWidget *cpus_label = gtk_label_new("CPUs:");
+    GtkWidget *cpus_entry = gtk_entry_new();
+    char cpus_text[16];
+    snprintf(cpus_text, sizeof(cpus_text), "%d", num_cpus);
+    gtk_entry_set_text(GTK_ENTRY(cpus_entry), cpus_text);
+    gtk_box_pack_start(GTK_BOX(cpus_box), cpus_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(cpus_box), cpus_entry, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(vbox), cpus_box, FALSE, FALSE, 5);
+
     // Initially hide the quantum box since FCFS is selected by default
     gtk_widget_set_sensitive(quantum_box, FALSE);
     
@@ -141,25 +166,28 @@ void on_choose_scheduler(GtkButton *button, gpointer user_data) {
         const gchar *quantum_text = gtk_entry_get_text(GTK_ENTRY(quantum_entry));
         int quantum = atoi(quantum_text);
         
-        // Create the appropriate scheduler
-        switch (selected) {
-            case 0: // FCFS
-                scheduler = create_fcfs_scheduler();
-                log_message("Scheduler: FCFS selected.");
-                break;
-            case 1: // Round Robin
-                scheduler = create_rr_scheduler(quantum);
-                char buffer[64];
-                snprintf(buffer, sizeof(buffer), "Scheduler: Round Robin selected with quantum %d.", quantum);
-                log_message(buffer);
-                break;
-            case 2: // MLFQ
-                scheduler = create_mlfq_scheduler();
-                log_message("Scheduler: MLFQ selected.");
-                break;
-            default:
-                log_message("No scheduler selected.");
-                break;
+        int cpus_wanted = atoi(gtk_entry_get_text(GTK_ENTRY(cpus_entry)));
+        if (sim_set_cpus(cpus_wanted) < 0) {
+            log_message("Invalid number of CPUs, keeping the current one.");
+        }
+
+        // Create the appropriate scheduler, one per CPU
+        int type = selected + 1;
+        char buffer[96];
+        if (selected < 0 || sim_set_scheduler(type, quantum) < 0) {
+            log_message("No scheduler selected.");
+        } else if (type == SCHEDULER_RR && quantum == RR_ADAPTIVE) {
+            log_message("Scheduler: Round Robin selected with an adaptive quantum.");
+        } else if (type == SCHEDULER_RR) {
+            snprintf(buffer, sizeof(buffer), "Scheduler: Round Robin selected with quantum %d.", quantum);
+            log_message(buffer);
+        } else {
+            snprintf(buffer, sizeof(buffer), "Scheduler: %s selected.", scheduler_type_name(type));
+            log_message(buffer);
+        }
+        if (num_cpus > 1) {
+            snprintf(buffer, sizeof(buffer), "Running on %d CPUs.", num_cpus);
+            log_message(buffer);
         }
     } else {
         log_message("Scheduler selection canceled.");
@@ -173,8 +201,8 @@ void on_scheduler_combo_changed(GtkComboBox *combo, gpointer user_data) {
     GtkWidget *quantum_box = GTK_WIDGET(user_data);
     int selected = gtk_combo_box_get_active(combo);
     
-    // Enable quantum input only for Round Robin (selection index 1)
-    if (selected == 1) {
+    // Enable quantum input only for schedulers that use it (Round Robin)
+    if (scheduler_takes_quantum(selected + 1)) {
         gtk_widget_set_sensitive(quantum_box, TRUE);
     } else {
         gtk_widget_set_sensitive(quantum_box, FALSE);
@@ -216,6 +244,33 @@ void on_add_process(GtkButton *button, gpointer user_data) {
     gtk_box_pack_start(GTK_BOX(vbox), time_label, TRUE, TRUE, 0);
     gtk_box_pack_start(GTK_BOX(vbox), time_entry, TRUE, TRUE, 0);
 
+    // Optional deadline and period for EDF / rate-monotonic
+    GtkWidget *deadline_label = gtk_label_new("Deadline (ticks after arrival, 0 = none):");
+    GtkWidget *deadline_entry = gtk_entry_new();
+    gtk_entry_set_text(GTK_ENTRY(deadline_entry), "0");
+    gtk_box_pack_start(GTK_BOX(vbox), deadline_label, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(vbox), deadline_entry, TRUE, TRUE, 0);
+
+    GtkWidget *period_label = gtk_label_new("Period (ticks, 0 = none):");
+    GtkWidget *period_entry = gtk_entry_new();
+    gtk_entry_set_text(GTK_ENTRY(period_entry), "0");
+    gtk_box_pack_start(GTK_BOX(vbox), period_label, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(vbox), period_entry, TRUE, TRUE, 0);
+
+    // CPU share for lottery / stride
+    GtkWidget *tickets_label = gtk_label_new("Tickets (lottery/stride):");
+    GtkWidget *tickets_entry = gtk_entry_new();
+    gtk_entry_set_text(GTK_ENTRY(tickets_entry), "100");
+    gtk_box_pack_start(GTK_BOX(vbox), tickets_label, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(vbox), tickets_entry, TRUE, TRUE, 0);
+
+    // CPU weight for CFS
+    GtkWidget *nice_label = gtk_label_new("Nice (CFS, 0 = full weight .. 9):");
+    GtkWidget *nice_entry = gtk_entry_new();
+    gtk_entry_set_text(GTK_ENTRY(nice_entry), "0");
+    gtk_box_pack_start(GTK_BOX(vbox), nice_label, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(vbox), nice_entry, TRUE, TRUE, 0);
+
     gtk_widget_show_all(dialog);
 
     // Run the dialog
@@ -225,11 +280,15 @@ void on_add_process(GtkButton *button, gpointer user_data) {
         const gchar *filename = gtk_combo_box_text_get_active_text(GTK_COMBO_BOX_TEXT(program_combo));
         const gchar *time_str = gtk_entry_get_text(GTK_ENTRY(time_entry));
         int arrival_time = atoi(time_str);
+        int deadline = atoi(gtk_entry_get_text(GTK_ENTRY(deadline_entry)));
+        int period = atoi(gtk_entry_get_text(GTK_ENTRY(period_entry)));
+        int tickets = atoi(gtk_entry_get_text(GTK_ENTRY(tickets_entry)));
+        int nice = atoi(gtk_entry_get_text(GTK_ENTRY(nice_entry)));
 
         // Create a temporary file to store the input
         FILE* temp_file = fopen("temp_input.txt", "w");
         if (temp_file) {
-            fprintf(temp_file, "%s\n%d", filename, arrival_time);
+            fprintf(temp_file, "%s\n%d\n%d %d %d %d", filename, arrival_time, deadline, period, tickets, nice);
             fclose(temp_file);
             
             // Call add_process with the temporary file
@@ -259,7 +318,7 @@ void on_auto_run_toggle(GtkToggleButton *toggle, gpointer user_data) {
     auto_mode = gtk_toggle_button_get_active(toggle);
     if (auto_mode) {
         // Check if we have processes and a scheduler
-        if (num_processes == 0) {
+        if (proc_count() == 0) {
             log_message("Error: No processes added. Please add processes first.");
             gtk_toggle_button_set_active(toggle, FALSE);
             auto_mode = 0;
@@ -284,8 +343,7 @@ void on_auto_run_toggle(GtkToggleButton *toggle, gpointer user_data) {
 
 gboolean auto_run_callback(gpointer data) {
     if (auto_mode && simulation_running) {
-        load_program();
-        simulation_step();
+        simulation_step();  // admits new arrivals first
         update_grid_display();  // Update grid during auto-run
         return TRUE;  // Keep the timeout active
     }
@@ -293,9 +351,12 @@ gboolean auto_run_callback(gpointer data) {
 }
 
 void on_reset(GtkButton *button, gpointer user_data) {
-    if (scheduler) scheduler->destroy(scheduler);
+    sim_destroy_scheduler();
+    discard_pcb_updates();
     mem_init();
+    text_segment_reset();
     sem_init_all();
+    sim_reset_processes();
     clock_tick = 0;
     simulation_running = 0;
     auto_mode = 0;
@@ -324,17 +385,16 @@ void on_stop(GtkButton *button, gpointer user_data) {
         log_message("Simulation paused.");
     } else {
         // If already stopped, exit the application
-        if (scheduler) scheduler->destroy(scheduler);
+        sim_destroy_scheduler();
         gtk_main_quit();
     }
 }
 
 void update_resource_panel(GtkWidget* panel) {
-    resource_status_t status[MAX_SEMAPHORES];
     int num_resources;
     
     // Get current resource status
-    get_resource_status(status, &num_resources);
+    resource_status_t *status = get_resource_status(&num_resources);
     
     // Clear existing widgets in the panel
     GList *children = gtk_container_get_children(GTK_CONTAINER(panel));
@@ -353,7 +413,7 @@ void update_resource_panel(GtkWidget* panel) {
     gtk_label_set_xalign(GTK_LABEL(title_label), 0);
     gtk_box_pack_start(GTK_BOX(vbox), title_label, FALSE, FALSE, 0);
     
-    // Display all resources (we should have exactly 3)
+    // Display all resources, the standard three first
     for (int i = 0; i < num_resources; i++) {
         // Create frame for this resource
         GtkWidget *frame = gtk_frame_new(status[i].name);
@@ -367,16 +427,25 @@ void update_resource_panel(GtkWidget* panel) {
         
         // Add status label
         char status_text[256];
-        snprintf(status_text, sizeof(status_text), 
-                "Status: %s", 
-                status[i].value ? "Free" : "Locked");
+        if (status[i].count > 1) {
+            snprintf(status_text, sizeof(status_text), "Status: %d of %d free",
+                    status[i].value, status[i].count);
+        } else {
+            snprintf(status_text, sizeof(status_text), 
+                    "Status: %s", 
+                    status[i].value ? "Free" : "Locked");
+        }
         GtkWidget *status_label = gtk_label_new(status_text);
         gtk_label_set_xalign(GTK_LABEL(status_label), 0);
         gtk_box_pack_start(GTK_BOX(resource_box), status_label, FALSE, FALSE, 0);
         
         // Add holder label
         char holder_text[256];
-        if (status[i].current_holder != -1) {
+        pcb_t *holder = proc_lookup(status[i].current_holder);
+        if (holder) {
+            snprintf(holder_text, sizeof(holder_text), "Current Holder: PID %d (%s)",
+                     holder->pid, state_type_to_string(holder->state));
+        } else if (status[i].current_holder != -1) {
             snprintf(holder_text, sizeof(holder_text), "Current Holder: PID %d", status[i].current_holder);
         } else {
             snprintf(holder_text, sizeof(holder_text), "Current Holder: None");
@@ -388,11 +457,16 @@ void update_resource_panel(GtkWidget* panel) {
         // Add waiting queue label
         char queue_text[256] = "Waiting Queue: ";
         if (status[i].queue_size > 0) {
-            char pid_str[16];
+            // As many as fit on the label
+            size_t len = strlen(queue_text);
             for (int j = 0; j < status[i].queue_size; j++) {
-                if (j > 0) strcat(queue_text, ", ");
-                snprintf(pid_str, sizeof(pid_str), "PID %d", status[i].waiting_pids[j]);
-                strcat(queue_text, pid_str);
+                int n = snprintf(queue_text + len, sizeof(queue_text) - len, "%sPID %d",
+                                 j > 0 ? ", " : "", status[i].waiting_pids[j]);
+                if (n < 0 || (size_t) n >= sizeof(queue_text) - len) {
+                    queue_text[len] = '\0';
+                    break;
+                }
+                len += n;
             }
         } else {
             strcat(queue_text, "Empty");
@@ -403,18 +477,21 @@ void update_resource_panel(GtkWidget* panel) {
     }
     
     // Free allocated memory for waiting PIDs
-    for (int i = 0; i < num_resources; i++) {
-        if (status[i].waiting_pids) {
-            free(status[i].waiting_pids);
-        }
-    }
+    free_resource_status(status, num_resources);
     
     // Show all widgets
     gtk_widget_show_all(panel);
 }
 
+// Semaphore state changed: redraw the resource panel
+static void gui_resources_changed(void) {
+    if (resource_panel) {
+        update_resource_panel(resource_panel);
+    }
+}
+
 // Function to get program input through GUI
-int get_program_input(int pid) {
+static int gui_program_input(int pid) {
     input_received = 0;
     program_input_value = 0;
     is_text_input = 0;  // Reset text input flag
@@ -478,12 +555,12 @@ int get_program_input(int pid) {
 }
 
 // Function to check if the input was text
-int is_program_text_input() {
+static int gui_input_is_text(void) {
     return is_text_input;
 }
 
 // Function to get the text input
-const char* get_program_text_input() {
+static const char* gui_input_text(void) {
     return program_text_input;
 }
 
@@ -494,23 +571,22 @@ int is_input_received() {
 
 // Function to add current state to history
 void add_to_history() {
-    if (history_count >= MAX_HISTORY) {
-        // Shift all entries down by one
-        for (int i = 0; i < MAX_HISTORY - 1; i++) {
-            process_history[i] = process_history[i + 1];
-        }
-        history_count--;
-    }
-    
     // Add current state for each process
-    for (int i = 0; i < num_processes; i++) {
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+        if (history_count >= MAX_HISTORY) {
+            // Shift all entries down by one
+            for (int i = 0; i < MAX_HISTORY - 1; i++) {
+                process_history[i] = process_history[i + 1];
+            }
+            history_count--;
+        }
         process_history[history_count].time = clock_tick;
-        process_history[history_count].pid = processes[i].pid;
+        process_history[history_count].pid = p->pid;
         strncpy(process_history[history_count].state, 
-                state_type_to_string(processes[i].state), 
+                state_type_to_string(p->state), 
                 sizeof(process_history[history_count].state) - 1);
-        process_history[history_count].priority = processes[i].priority;
-        process_history[history_count].pc = processes[i].pc;
+        process_history[history_count].priority = p->priority;
+        process_history[history_count].pc = p->pc;
         history_count++;
     }
 }
@@ -518,17 +594,7 @@ void add_to_history() {
 // Function to get scheduler name
 const char* get_scheduler_name() {
     if (!scheduler) return "None";
-    
-    switch (scheduler->type) {
-        case SCHEDULER_FCFS:
-            return "FCFS";
-        case SCHEDULER_RR:
-            return "Round Robin";
-        case SCHEDULER_MLFQ:
-            return "MLFQ";
-        default:
-            return "Unknown";
-    }
+    return scheduler_type_name(scheduler->type);
 }
 
 // Function to create the overview section
@@ -660,21 +726,24 @@ void update_queue_display(GtkWidget* queue_section) {
         }
         
         // Get running process
-        for (int i = 0; i < num_processes; i++) {
-            if (processes[i].state == RUNNING) {
-                snprintf(running_text, sizeof(running_text), "PID %d", processes[i].pid);
+        for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+            if (p->state == RUNNING) {
+                snprintf(running_text, sizeof(running_text), "PID %d", p->pid);
                 break;
             }
         }
         
-        // Get blocked queue
-        for (int i = 0; i < num_processes; i++) {
-            if (processes[i].state == BLOCKED) {
-                if (strlen(blocked_text) > 0) strcat(blocked_text, ", ");
-                char pid_str[16];
-                snprintf(pid_str, sizeof(pid_str), "PID %d", processes[i].pid);
-                strcat(blocked_text, pid_str);
+        // Get blocked queue (as many as fit on the label)
+        get_blocked_queue();
+        size_t len = 0;
+        for (int i = 0; blocked_queue && blocked_queue[i]; i++) {
+            int n = snprintf(blocked_text + len, sizeof(blocked_text) - len, "%sPID %d",
+                             len > 0 ? ", " : "", blocked_queue[i]->pid);
+            if (n < 0 || (size_t) n >= sizeof(blocked_text) - len) {
+                blocked_text[len] = '\0';
+                break;
             }
+            len += n;
         }
     }
     
@@ -805,7 +874,7 @@ GtkWidget* create_memory_viewer() {
         (GtkTreeCellDataFunc) cell_background_func, GINT_TO_POINTER(3), NULL);
     
     // Initialize tree view with empty data
-    for (int i = 0; i < MAX_MEM_WORDS; i++) {
+    for (int i = 0; i < mem_pool_size; i++) {
         GtkTreeIter iter;
         gtk_list_store_append(store, &iter);
         gtk_list_store_set(store, &iter,
@@ -855,20 +924,21 @@ void update_memory_viewer(GtkWidget *viewer) {
     GtkListStore *store = g_object_get_data(G_OBJECT(viewer), "memory_store");
     if (!store) return;
     
-    // Update each row with memory_pool data
-    for (int i = 0; i < MAX_MEM_WORDS; i++) {
-        GtkTreeIter iter;
-        if (gtk_tree_model_iter_nth_child(GTK_TREE_MODEL(store), &iter, NULL, i)) {
-            // Check if memory cell has data
-            gboolean used = (memory_pool[i].name[0] != '\0');
-            
-            // Update the row
-            gtk_list_store_set(store, &iter,
-                              1, used ? memory_pool[i].name : "",    // Name
-                              2, used ? memory_pool[i].value : "",   // Value
-                              3, used,                               // Used status
-                              -1);
-        }
+    // Update each row with memory_pool data (walk the rows in order; nth_child
+    // would make a large pool quadratic)
+    GtkTreeIter iter;
+    gboolean valid = gtk_tree_model_get_iter_first(GTK_TREE_MODEL(store), &iter);
+    for (int i = 0; i < mem_pool_size && valid; i++) {
+        // Check if memory cell has data
+        gboolean used = (memory_pool[i].name[0] != '\0');
+        
+        // Update the row
+        gtk_list_store_set(store, &iter,
+                          1, used ? memory_pool[i].name : "",    // Name
+                          2, used ? mem_text(i) : "",            // Value
+                          3, used,                               // Used status
+                          -1);
+        valid = gtk_tree_model_iter_next(GTK_TREE_MODEL(store), &iter);
     }
 }
 
@@ -881,7 +951,7 @@ void update_grid_display() {
              "Total Processes: %d\n"
              "Current Clock: %d\n"
              "Scheduler: %s",
-             num_processes,
+             proc_count(),
              clock_tick,
              get_scheduler_name());
     gtk_label_set_text(GTK_LABEL(overview_label), buffer);
@@ -889,16 +959,16 @@ void update_grid_display() {
     // Update Process List
     gtk_list_store_clear(GTK_LIST_STORE(process_store));
     
-    for (int i = 0; i < num_processes; i++) {
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
         GtkTreeIter iter;
         gtk_list_store_append(GTK_LIST_STORE(process_store), &iter);
         gtk_list_store_set(GTK_LIST_STORE(process_store), &iter,
-                          0, processes[i].pid,
-                          1, state_type_to_string(processes[i].state),
-                          2, processes[i].priority,
-                          3, processes[i].mem_low,
-                          4, processes[i].mem_high,
-                          5, processes[i].pc,
+                          0, p->pid,
+                          1, state_type_to_string(p->state),
+                          2, p->priority,
+                          3, p->mem_low,
+                          4, p->mem_high,
+                          5, p->pc,
                           -1);
     }
     
@@ -915,6 +985,7 @@ void update_grid_display() {
 // Initialize GUI and return the window widget
 GtkWidget* init_gui(int argc, char *argv[]) {
     gtk_init(&argc, &argv);
+    io_set_backend(&gui_io);
 
     window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
     gtk_window_set_title(GTK_WINDOW(window), "Scheduler Simulation");
@@ -1091,7 +1162,7 @@ void run_gui() {
 }
 
 // Function to get file content through GUI
-char* get_file_content(const char* filename) {
+static char* gui_read_file(const char* filename) {
     static char file_buffer[1024];
     file_buffer[0] = '\0'; // Initialize to empty string
     
@@ -1196,7 +1267,7 @@ char* get_file_content(const char* filename) {
 }
 
 // Function to write content to a file through GUI
-int write_file_content(const char* filename, const char* content) {
+static int gui_write_file(const char* filename, const char* content) {
     int success = 0;
     
     // Create a dialog for file writing
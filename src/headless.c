@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/os.h"
+#include "../include/memory.h"
+#include "../include/semaphore.h"
+#include "../include/scheduler_interface.h"
+#include "../include/scheduler_factory.h"
+#include "../include/io.h"
+#include "../include/simulation.h"
+
+// Batch runner: no GTK, no dialogs. Runs the workload given on the command
+// line to completion as fast as it can.
+
+// Scripted program input (--inputs=a,b,...), handed out in order
+static char *input_list = NULL;
+static char **inputs = NULL;
+static int n_inputs = 0;
+static int next_input = 0;
+static int last_was_text = 0;
+static const char *last_text = "";
+
+static int scripted_input(int pid) {
+    (void) pid;
+    last_was_text = 0;
+    if (next_input >= n_inputs) return 0;  // script exhausted
+
+    const char *token = inputs[next_input++];
+    char *end;
+    long value = strtol(token, &end, 10);
+    if (*end == '\0' && end != token) return (int) value;
+
+    last_text = token;
+    last_was_text = 1;
+    return 0;
+}
+
+static int scripted_input_is_text(void) {
+    return last_was_text;
+}
+
+static const char *scripted_input_text(void) {
+    return last_text;
+}
+
+static void quiet_log(const char *message) {
+    (void) message;
+}
+
+static void set_inputs(const char *list) {
+    input_list = strdup(list);
+    char *save = NULL;
+    for (char *tok = strtok_r(input_list, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+        char **grown = realloc(inputs, (n_inputs + 1) * sizeof(char*));
+        if (!grown) break;
+        inputs = grown;
+        inputs[n_inputs++] = tok;
+    }
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options] program[@arrival[:deadline[:period[:tickets[:nice]]]]] ...\n"
+           "  --scheduler=POLICY     ", prog);
+    for (int type = 1; type <= scheduler_count(); type++) {
+        printf("%s%s", type > 1 ? "|" : "", scheduler_short_name(type));
+    }
+    printf("\n"
+           "                         (default fcfs)\n"
+           "  --quantum=N            Round Robin quantum (default 2, 0 = adaptive)\n"
+           "  --inputs=v1,v2,...     program input, in order (default: read stdin)\n"
+           "  --max-ticks=N          give up after N ticks (default 100000)\n"
+           "  --quiet                only print program output, errors and reports\n"
+           "  --dump-memory          print the memory pool when done\n"
+           "  --mlfq-levels=N, --mlfq-quanta=q0,q1,..., --mlfq-boost=TICKS\n"
+           "  --lottery-seed=N, --cpus=N, --event-driven\n"
+           "  --mem-words=N, --fit=first|best|next, --program-cache=DIR\n"
+           "  --resources=FILE       resource counts, one \"name count\" per line\n"
+           "  --scheduler-module=PATH  load a scheduler from a shared object\n"
+           "                         (NAME.so exporting create_NAME_scheduler)\n");
+}
+
+int main(int argc, char *argv[]) {
+    sim_parse_options(&argc, argv);
+
+    const char *policy = "fcfs";
+    int quantum = 2;
+    int max_ticks = 100000;
+    int dump_memory = 0;
+    io_backend_t io = io_stdio_backend;
+
+    mem_init();
+    sem_init_all();
+
+    int n_programs = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--scheduler=", 12) == 0) {
+            policy = argv[i] + 12;
+        } else if (strncmp(argv[i], "--quantum=", 10) == 0) {
+            quantum = atoi(argv[i] + 10);
+        } else if (strncmp(argv[i], "--inputs=", 9) == 0) {
+            set_inputs(argv[i] + 9);
+            io.input = scripted_input;
+            io.input_is_text = scripted_input_is_text;
+            io.input_text = scripted_input_text;
+        } else if (strncmp(argv[i], "--max-ticks=", 12) == 0) {
+            max_ticks = atoi(argv[i] + 12);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            io.trace = quiet_log;
+        } else if (strcmp(argv[i], "--dump-memory") == 0) {
+            dump_memory = 1;
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            usage(argv[0]);
+            return 2;
+        } else {
+            // program[@arrival[:deadline[:period[:tickets[:nice]]]]]
+            char filename[MAX_LINE_LEN];
+            int arrival_time = 0;
+            proc_params_t params = { 0, 0, 0, 0 };
+            if (sscanf(argv[i], "%127[^@]@%d:%d:%d:%d:%d", filename, &arrival_time,
+                       &params.deadline, &params.period, &params.tickets, &params.nice) < 1 ||
+                sim_add_process(filename, arrival_time, &params) < 0) {
+                return 1;
+            }
+            n_programs++;
+        }
+    }
+    if (n_programs == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    io_set_backend(&io);
+
+    int type = scheduler_type_by_name(policy);
+    if (type < 0) {
+        printf("Unknown scheduler '%s'.\n", policy);
+        return 2;
+    }
+    if (sim_set_scheduler(type, quantum) < 0) {
+        printf("Failed to create scheduler. Out of memory.\n");
+        return 1;
+    }
+
+    simulation_running = 1;
+    tick_limit = max_ticks;
+    while (simulation_running && clock_tick < max_ticks) {
+        simulation_step();
+    }
+
+    if (dump_memory) {
+        for (int i = 0; i < mem_pool_size; i++) {
+            printf("MEM %d %s=%s\n", i, memory_pool[i].name, mem_text(i));
+        }
+    }
+
+    int status = 0;
+    if (simulation_running) {
+        printf("Stopped after %d ticks with processes still running.\n", clock_tick);
+        sim_report_shares();
+        sim_report_cpus();
+        status = 1;
+    }
+    sim_destroy_scheduler();
+    free(inputs);
+    free(input_list);
+    return status;
+}
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/io.h"
+
+static char text_input[256] = "";
+static int text_input_set = 0;
+
+static void stdio_log(const char *message) {
+    // Messages may or may not end their line
+    size_t len = strlen(message);
+    fputs(message, stdout);
+    if (len == 0 || message[len - 1] != '\n') putchar('\n');
+}
+
+// One whitespace-separated token from stdin: a number, or text
+static int stdio_input(int pid) {
+    char token[256];
+    printf("Enter value for Process %d: ", pid);
+    fflush(stdout);
+    text_input_set = 0;
+    if (scanf("%255s", token) != 1) return 0;
+
+    char *end;
+    long value = strtol(token, &end, 10);
+    if (*end == '\0') return (int) value;
+
+    strcpy(text_input, token);
+    text_input_set = 1;
+    return 0;
+}
+
+static int stdio_input_is_text(void) {
+    return text_input_set;
+}
+
+static const char *stdio_input_text(void) {
+    return text_input;
+}
+
+static char *stdio_read_file(const char *filename) {
+    static char file_buffer[1024];
+    file_buffer[0] = '\0';
+
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        char log_msg[256];
+        snprintf(log_msg, sizeof(log_msg), "Error: Could not open file '%s'", filename);
+        log_message(log_msg);
+        return file_buffer;
+    }
+    size_t n = fread(file_buffer, 1, sizeof(file_buffer) - 1, file);
+    file_buffer[n] = '\0';
+    fclose(file);
+    return file_buffer;
+}
+
+static int stdio_write_file(const char *filename, const char *content) {
+    FILE *file = fopen(filename, "w");
+    if (!file) return 0;
+    int ok = fputs(content, file) >= 0;
+    return (fclose(file) == 0) && ok;
+}
+
+const io_backend_t io_stdio_backend = {
+    .log = stdio_log,
+    .trace = NULL,
+    .input = stdio_input,
+    .input_is_text = stdio_input_is_text,
+    .input_text = stdio_input_text,
+    .read_file = stdio_read_file,
+    .write_file = stdio_write_file,
+    .resources_changed = NULL
+};
+
+static io_backend_t installed;
+static const io_backend_t *io = &io_stdio_backend;
+
+void io_set_backend(const io_backend_t *backend) {
+    if (!backend) {
+        io = &io_stdio_backend;
+        return;
+    }
+    installed = *backend;
+    io = &installed;
+}
+
+void log_message(const char *message) {
+    if (io->log) io->log(message);
+}
+
+void log_trace(const char *message) {
+    if (io->trace) io->trace(message);
+    else log_message(message);
+}
+
+int get_program_input(int pid) {
+    return io->input(pid);
+}
+
+int is_program_text_input() {
+    return io->input_is_text();
+}
+
+const char* get_program_text_input() {
+    return io->input_text();
+}
+
+char* get_file_content(const char* filename) {
+    return io->read_file(filename);
+}
+
+int write_file_content(const char* filename, const char* content) {
+    return io->write_file(filename, content);
+}
+
+void notify_resources_changed(void) {
+    if (io->resources_changed) io->resources_changed();
+}
@@ -0,0 +1,137 @@
+// src/keyed_heap_scheduler.c
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/keyed_heap_scheduler.h"
+#include "../include/io.h"
+
+static void enqueue_keyed(Scheduler *self, pcb_t *proc) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    if (ph_push(&kh->ready, kh->policy->key(kh, proc), proc) < 0) {
+        printf("Error: out of memory queueing process %d\n", proc->pid);
+        return;
+    }
+    proc->state = READY;
+    pcb_enter_queue(proc); // Wait time counts from now
+}
+
+// Take the running process off the CPU and back into the heap
+static void requeue(Scheduler *self, pcb_t *proc) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    proc->state = READY;
+    update_pcb_in_memory(proc); // Update PCB in memory
+    kh->current = NULL;
+    enqueue_keyed(self, proc);
+}
+
+static pcb_t* next_keyed(Scheduler *self) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    const keyed_heap_policy_t *pol = kh->policy;
+
+    if (kh->current && kh->current->state == RUNNING) {
+        pcb_t *proc = kh->current;
+        long own = pol->preemptive ? pol->key(kh, proc) : 0;
+        if (!pol->preemptive || ph_empty(&kh->ready) || ph_top_key(&kh->ready) >= own) {
+            // If current process is still running, return it
+            return proc;
+        }
+        // A process with a smaller key arrived or woke up and takes over
+        char buffer[128];
+        if (pol->key_unit) {
+            snprintf(buffer, sizeof(buffer), "%s: process %d (%ld %s) preempts process %d (%ld %s)\n",
+                    pol->name, ph_top(&kh->ready)->pid, ph_top_key(&kh->ready), pol->key_unit,
+                    proc->pid, own, pol->key_unit);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s: process %d preempts process %d\n",
+                    pol->name, ph_top(&kh->ready)->pid, proc->pid);
+        }
+        log_trace(buffer);
+        requeue(self, proc);
+    }
+
+    kh->current = ph_pop(&kh->ready);
+    if (kh->current) {
+        pcb_leave_queue(kh->current); // Reset time in queue for the running process
+    }
+    if (pol->settle) pol->settle(kh);
+    return kh->current;
+}
+
+static void preempt_keyed(Scheduler *self, pcb_t *proc) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    const keyed_heap_policy_t *pol = kh->policy;
+
+    if (pol->charge) pol->charge(kh, proc);
+    if (pol->yields && pol->yields(kh, proc)) {
+        requeue(self, proc);
+    } else {
+        // Let it continue
+        kh->current = proc;
+    }
+    if (pol->settle) pol->settle(kh);
+}
+
+static void destroy_keyed(Scheduler *self) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    ph_free(&kh->ready);
+    free(self->data);
+    free(self);
+}
+
+static void dequeue_keyed(Scheduler* sched, pcb_t* proc) {
+    keyed_heap_t *kh = (keyed_heap_t*) sched->data;
+    // Only the running process blocks itself, and it is not in the heap;
+    // the tick it blocked in still counts
+    if (kh->policy->charge) kh->policy->charge(kh, proc);
+    if (kh->current == proc) kh->current = NULL;
+    if (kh->policy->settle) kh->policy->settle(kh);
+}
+static pcb_t* queue_keyed(Scheduler *self) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    return ph_top(&kh->ready);
+}
+static int queue_size_keyed(Scheduler *self) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    return ph_size(&kh->ready);
+}
+static int queue_empty_keyed(Scheduler *self) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    return ph_empty(&kh->ready);
+}
+static pcb_t* steal_keyed(Scheduler *self) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    // The running process is not in the heap
+    return ph_pop_last(&kh->ready);
+}
+static void purge_keyed(Scheduler *self, pcb_t *proc) {
+    keyed_heap_t *kh = (keyed_heap_t*) self->data;
+    ph_remove(&kh->ready, proc);
+}
+
+Scheduler* create_keyed_heap_scheduler(int type, const keyed_heap_policy_t *policy) {
+    Scheduler *s = malloc(sizeof(Scheduler));
+    if (!s) return NULL;
+
+    keyed_heap_t *kh = calloc(1, sizeof(keyed_heap_t));
+    if (!kh || ph_init(&kh->ready, 0) < 0) {
+        free(kh);
+        free(s);
+        return NULL;
+    }
+    kh->policy = policy;
+    s->data = kh;
+
+    s->type = type;
+    s->scheduler_enqueue = enqueue_keyed;
+    s->next = next_keyed;
+    s->preempt = preempt_keyed;
+    s->destroy = destroy_keyed;
+    s->scheduler_dequeue = dequeue_keyed;
+    s->queue = queue_keyed;
+    s->queue_size = queue_size_keyed;
+    s->queue_empty = queue_empty_keyed;
+    s->steal = steal_keyed;
+    s->next_timer = NULL;
+    s->purge = purge_keyed;
+
+    return s;
+}
@@ -1,44 +1,359 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "../include/memory.h"
 //#include "../include/os.h"
 
-mem_word_t memory_pool[MAX_MEM_WORDS];
+mem_word_t *memory_pool = NULL;
+int mem_pool_size = 0;
+
+// Symbol index slot: a name hash and the first word in the block carrying it
+typedef struct {
+    uint64_t hash;
+    int      idx;      // -1 = empty slot
+} mem_sym_t;
+
+// Per-process symbol index, one per allocated block
+typedef struct {
+    int        n_words;   // words of the block still allocated
+    int        mask;      // capacity - 1 (capacity is a power of two)
+    mem_sym_t *slots;
+} mem_symtab_t;
+
+static uint64_t      *word_hash = NULL;  // hash of memory_pool[i].name
+static mem_symtab_t **word_block = NULL; // owning block, NULL if free
+
+// Occupancy bitmap: bit i set = word i allocated. Bits past the end of the
+// pool stay set so free-run scans stop there without a bounds check.
+static uint64_t *alloc_map = NULL;
+static int map_words = 0;
+static mem_fit_t fit_policy = MEM_FIRST_FIT;
+static int next_fit_cursor = 0;   // where the next next-fit search starts
+
+// FNV-1a; names are identified by their 64-bit hash inside a block
+static uint64_t name_hash(const char *name) {
+    uint64_t h = 14695981039346656037ULL;
+    while (*name) {
+        h ^= (unsigned char) *name++;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static mem_sym_t *symtab_find(mem_symtab_t *t, uint64_t hash) {
+    for (int i = (int) hash & t->mask; ; i = (i + 1) & t->mask) {
+        if (t->slots[i].idx < 0 || t->slots[i].hash == hash)
+            return &t->slots[i];
+    }
+}
+
+// Backward-shift deletion keeps probe chains intact without tombstones
+static void symtab_delete(mem_symtab_t *t, mem_sym_t *slot) {
+    int hole = (int) (slot - t->slots);
+    for (int i = (hole + 1) & t->mask; t->slots[i].idx >= 0; i = (i + 1) & t->mask) {
+        int home = (int) t->slots[i].hash & t->mask;
+        // Move the entry back if the hole lies on its probe path
+        if (((i - home) & t->mask) >= ((i - hole) & t->mask)) {
+            t->slots[hole] = t->slots[i];
+            hole = i;
+        }
+    }
+    t->slots[hole].idx = -1;
+}
+
+// Drop word `idx` from its block's index (before its name changes)
+static void symtab_unlink(int idx) {
+    mem_symtab_t *t = word_block[idx];
+    if (!t || memory_pool[idx].name[0] == '\0') return;
+
+    mem_sym_t *slot = symtab_find(t, word_hash[idx]);
+    if (slot->idx != idx) return;  // an earlier word owns this name
+
+    // Hand the name over to the next word in the block that carries it
+    for (int i = idx + 1; i < mem_pool_size && word_block[i] == t; i++) {
+        if (memory_pool[i].name[0] != '\0' && word_hash[i] == word_hash[idx]) {
+            slot->idx = i;
+            return;
+        }
+    }
+    symtab_delete(t, slot);
+}
+
+static void symtab_link(int idx) {
+    mem_symtab_t *t = word_block[idx];
+    if (!t || memory_pool[idx].name[0] == '\0') return;
+
+    mem_sym_t *slot = symtab_find(t, word_hash[idx]);
+    if (slot->idx < 0 || idx < slot->idx) {
+        slot->hash = word_hash[idx];
+        slot->idx = idx;
+    }
+}
+
+// First word at or after `from` whose bit equals `set`, or mem_pool_size
+static int map_scan(int from, int set) {
+    while (from < mem_pool_size) {
+        uint64_t w = alloc_map[from >> 6];
+        if (!set) w = ~w;
+        w &= ~0ULL << (from & 63);
+        if (w) {
+            int i = (from & ~63) + __builtin_ctzll(w);
+            return i < mem_pool_size ? i : mem_pool_size;
+        }
+        from = (from & ~63) + 64;
+    }
+    return mem_pool_size;
+}
+
+static void map_set_range(int start, int n_words, int set) {
+    int end = start + n_words;
+    while (start < end) {
+        int bit = start & 63;
+        int span = (end - start < 64 - bit) ? end - start : 64 - bit;
+        uint64_t mask = (span == 64 ? ~0ULL : ((1ULL << span) - 1)) << bit;
+        if (set) alloc_map[start >> 6] |= mask;
+        else     alloc_map[start >> 6] &= ~mask;
+        start += span;
+    }
+}
+
+// Walk free runs [s, e) a bitmap word at a time; the first long enough wins
+static int fit_first(int from, int limit, int n_words) {
+    for (int s = map_scan(from, 0); s < limit; s = map_scan(s, 0)) {
+        int e = map_scan(s, 1);
+        if (e - s >= n_words) return s;
+        s = e;
+    }
+    return -1;
+}
+
+// Smallest free run that still fits, lowest address on ties
+static int fit_best(int n_words) {
+    int best = -1, best_len = 0;
+    for (int s = map_scan(0, 0); s < mem_pool_size; s = map_scan(s, 0)) {
+        int e = map_scan(s, 1);
+        int len = e - s;
+        if (len == n_words) return s;  // exact fit, cannot do better
+        if (len > n_words && (best < 0 || len < best_len)) {
+            best = s;
+            best_len = len;
+        }
+        s = e;
+    }
+    return best;
+}
+
+void mem_set_fit_policy(mem_fit_t policy) {
+    fit_policy = policy;
+}
+
+static void pool_release(void) {
+    free(memory_pool);
+    free(word_hash);
+    free(word_block);
+    free(alloc_map);
+    memory_pool = NULL;
+    word_hash = NULL;
+    word_block = NULL;
+    alloc_map = NULL;
+    mem_pool_size = map_words = 0;
+}
+
+int mem_set_size(int n_words) {
+    if (n_words <= 0) return -1;
+
+    // Drop the old pool (and every block index living in it) first
+    if (memory_pool) {
+        for (int i = 0; i < mem_pool_size; i++) {
+            mem_symtab_t *t = word_block[i];
+            if (t && --t->n_words == 0) {
+                free(t->slots);
+                free(t);
+            }
+        }
+        pool_release();
+    }
+
+    map_words = (n_words + 63) / 64;
+    memory_pool = calloc(n_words, sizeof(mem_word_t));
+    word_hash = calloc(n_words, sizeof(uint64_t));
+    word_block = calloc(n_words, sizeof(mem_symtab_t*));
+    alloc_map = calloc(map_words, sizeof(uint64_t));
+    if (!memory_pool || !word_hash || !word_block || !alloc_map) {
+        pool_release();
+        return -1;
+    }
+    mem_pool_size = n_words;
+    mem_init();
+    return 0;
+}
 
 void mem_init(void) {
-    for (int i = 0; i < MAX_MEM_WORDS; i++){
+    if (!memory_pool && mem_set_size(MEM_DEFAULT_WORDS) < 0) return;
+    for (int i = 0; i < mem_pool_size; i++){
+        mem_symtab_t *t = word_block[i];
+        if (t && --t->n_words == 0) {
+            free(t->slots);
+            free(t);
+        }
+        word_block[i] = NULL;
         memory_pool[i].name[0] = '\0';
     }
+    memset(alloc_map, 0, map_words * sizeof(uint64_t));
+    if (mem_pool_size % 64)
+        alloc_map[map_words - 1] = ~0ULL << (mem_pool_size % 64);
+    next_fit_cursor = 0;
 }
 
 int mem_alloc(int n_words) {
-    for (int i = 0; i <= MAX_MEM_WORDS - n_words; i++) {
-        int free_block = 1;
-        for (int j = 0; j < n_words; j++){
-            if (memory_pool[i+j].name[0] != '\0'){
-                free_block = 0;
-            }    
-        }
-        if (free_block) return i;
+    if (n_words <= 0 || n_words > mem_pool_size) return -1;
+
+    int i;
+    switch (fit_policy) {
+        case MEM_BEST_FIT:
+            i = fit_best(n_words);
+            break;
+        case MEM_NEXT_FIT:
+            i = fit_first(next_fit_cursor, mem_pool_size, n_words);
+            if (i < 0) i = fit_first(0, next_fit_cursor, n_words);
+            break;
+        default:
+            i = fit_first(0, mem_pool_size, n_words);
+            break;
     }
-    return -1;
+    if (i < 0) return -1;
+
+    // Size the index so it stays at most half full
+    int cap = 4;
+    while (cap < 2 * n_words) cap <<= 1;
+
+    mem_symtab_t *t = malloc(sizeof(mem_symtab_t));
+    if (!t) return -1;
+    t->slots = malloc(cap * sizeof(mem_sym_t));
+    if (!t->slots) {
+        free(t);
+        return -1;
+    }
+    for (int j = 0; j < cap; j++) t->slots[j].idx = -1;
+    t->n_words = n_words;
+    t->mask = cap - 1;
+
+    for (int j = 0; j < n_words; j++) word_block[i+j] = t;
+    map_set_range(i, n_words, 1);
+    next_fit_cursor = (i + n_words) % mem_pool_size;
+    return i;
 }
 
 void mem_free(int start, int n_words) {
     for (int i = start; i < start + n_words; i++){
+        mem_symtab_t *t = word_block[i];
+        symtab_unlink(i);
         memory_pool[i].name[0] = '\0';
+        word_block[i] = NULL;
+        if (t && --t->n_words == 0) {
+            free(t->slots);
+            free(t);
+        }
     }
+    map_set_range(start, n_words, 0);
 }
 
-void mem_write(int idx, char *name, char *value) {
+// Point word `idx` at `name`, keeping the block's symbol index current
+static void word_set_name(int idx, char *name) {
+    uint64_t hash = name_hash(name);
+    if (memory_pool[idx].name[0] != '\0' && word_hash[idx] == hash) return;
+
+    symtab_unlink(idx);
     strncpy(memory_pool[idx].name, name, sizeof memory_pool[idx].name -1);
+    word_hash[idx] = hash;
+    symtab_link(idx);
+}
+
+void mem_write(int idx, char *name, char *value) {
+    word_set_name(idx, name);
     strncpy(memory_pool[idx].value, value, sizeof memory_pool[idx].value -1);
+    memory_pool[idx].type = MEM_TEXT;
+    memory_pool[idx].stale = 0;
 }
 
-char *mem_read(int low, int high, char *name) {
+void mem_write_int(int idx, char *name, int value) {
+    word_set_name(idx, name);
+    memory_pool[idx].type = MEM_INT;
+    memory_pool[idx].ival = value;
+    memory_pool[idx].stale = 1;
+}
+
+void mem_write_enum(int idx, char *name, int value, const char *const *labels) {
+    word_set_name(idx, name);
+    memory_pool[idx].type = MEM_ENUM;
+    memory_pool[idx].ival = value;
+    memory_pool[idx].labels = labels;
+    memory_pool[idx].stale = 1;
+}
+
+void mem_write_elapsed(int idx, char *name, int since, const int *clock) {
+    word_set_name(idx, name);
+    memory_pool[idx].type = MEM_ELAPSED;
+    memory_pool[idx].ival = since;
+    memory_pool[idx].clock = clock;
+}
+
+const char *mem_text(int idx) {
+    mem_word_t *w = &memory_pool[idx];
+    if (w->type == MEM_ELAPSED) {
+        snprintf(w->value, sizeof w->value, "%d", *w->clock - w->ival);
+    } else if (w->stale) {
+        if (w->type == MEM_INT)
+            snprintf(w->value, sizeof w->value, "%d", w->ival);
+        else
+            snprintf(w->value, sizeof w->value, "%s", w->labels[w->ival]);
+        w->stale = 0;
+    }
+    return w->value;
+}
+
+// Index of the first word called `name` in [low, high], or -1
+static int mem_find(int low, int high, char *name) {
+    if (name[0] == '\0') return -1;
+    uint64_t hash = name_hash(name);
+
+    // Single-word reads (instruction fetch) only need the word's own hash
+    if (low == high) {
+        if (memory_pool[low].name[0] != '\0' && word_hash[low] == hash)
+            return low;
+        return -1;
+    }
+
+    // The range lies inside one block: ask its index
+    mem_symtab_t *t = word_block[low];
+    if (t && word_block[high] == t) {
+        mem_sym_t *slot = symtab_find(t, hash);
+        if (slot->idx < 0 || slot->idx > high) return -1;
+        if (slot->idx >= low) return slot->idx;
+    }
+
+    // Ranges spanning blocks (or starting past the first match) fall back to a scan
     for (int i = low; i <= high; i++) {
-        if (strcmp(memory_pool[i].name, name) == 0){
-            return memory_pool[i].value;
+        if (memory_pool[i].name[0] != '\0' && word_hash[i] == hash){
+            return i;
         }
     }
-    return NULL;
+    return -1;
+}
+
+char *mem_read(int low, int high, char *name) {
+    int idx = mem_find(low, high, name);
+    if (idx < 0) return NULL;
+    return (char*) mem_text(idx);
+}
+
+int mem_read_int(int low, int high, char *name, int *out) {
+    int idx = mem_find(low, high, name);
+    if (idx < 0) return 0;
+    mem_word_t *w = &memory_pool[idx];
+    if (w->type == MEM_TEXT) *out = atoi(w->value);
+    else if (w->type == MEM_ELAPSED) *out = *w->clock - w->ival;
+    else *out = w->ival;
+    return 1;
 }
@@ -1,195 +1,251 @@
 // src/mlfq_scheduler.c
+#include <limits.h>
+#include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "../include/mlfq_scheduler.h"
-
-#define NUM_QUEUES 4
-#define MAX_QUEUE 100
+#include "../include/run_queue.h"
+#include "../include/io.h"
 
 typedef struct {
-    pcb_t* queue[MAX_QUEUE];
-    int head, tail;
+    run_queue_t ready;
     int quantum;     // quantum for this level
-    int ticks_used;  // ticks for current running process
-    pcb_t* current;  // currently running process
 } mlfq_queue_t;
 
 typedef struct {
-    mlfq_queue_t levels[NUM_QUEUES];
+    mlfq_queue_t* levels;
+    int n_levels;
+    uint64_t occupied;   // bit i set = level i has processes waiting
+    pcb_t* current;      // currently running process
+    int ticks_used;      // ticks for current running process
+    int boost_interval;  // rounds between priority boosts, 0 = never
+    int last_boost;      // sched_round of the last boost
 } mlfq_data_t;
 
+// Configuration used by create_mlfq_scheduler()
+static mlfq_config_t default_config = { MLFQ_DEFAULT_LEVELS, {0}, 0 };
+
 // Helper Functions
-static void queue_init(mlfq_queue_t* q, int quantum) {
-    q->head = q->tail = 0;
+static int queue_init(mlfq_queue_t* q, int quantum) {
     q->quantum = quantum;
-    q->ticks_used = 0;
-    q->current = NULL;
+    return rq_init(&q->ready, 0);
+}
+
+static void queue_push(mlfq_data_t* data, int level, pcb_t* proc) {
+    if (rq_push(&data->levels[level].ready, proc) < 0) {
+        printf("Error: out of memory queueing process %d\n", proc->pid);
+        return;
+    }
+    data->occupied |= 1ULL << level;
+    pcb_enter_queue(proc); // Wait time counts from now
 }
 
-static int queue_empty(mlfq_queue_t* q) {
-    return q->head == q->tail;
+static pcb_t* queue_pop(mlfq_data_t* data, int level) {
+    run_queue_t* rq = &data->levels[level].ready;
+    pcb_t* proc = rq_pop(rq);
+    if (rq_empty(rq)) data->occupied &= ~(1ULL << level);
+    return proc;
 }
 
-static void queue_push(mlfq_queue_t* q, pcb_t* proc) {
-    q->queue[q->tail++] = proc;
+// Highest-priority level with processes waiting, or -1
+static int top_level(const mlfq_data_t* data) {
+    return data->occupied ? __builtin_ctzll(data->occupied) : -1;
 }
 
-static pcb_t* queue_pop(mlfq_queue_t* q) {
-    if (queue_empty(q)) return NULL;
-    return q->queue[q->head++];
+// Clamp the priority of `proc` to an existing level
+static int proc_level(mlfq_data_t* data, pcb_t* proc) {
+    if (proc->priority < 0 || proc->priority >= data->n_levels) {
+        proc->priority = data->n_levels - 1;
+        update_pcb_in_memory(proc); // Update PCB in memory
+    }
+    return proc->priority;
 }
 
-static void queue_remove(mlfq_queue_t* q, pcb_t* proc) {
-    int new_tail = q->head;
-    for (int i = q->head; i < q->tail; i++) {
-        if (q->queue[i] != proc) {
-            q->queue[new_tail++] = q->queue[i];
+// Move every process back to the top level so nothing starves at the bottom.
+// Waiting processes keep their place in line and their wait time.
+static void priority_boost(mlfq_data_t* data) {
+    while (data->occupied & ~1ULL) {
+        int level = __builtin_ctzll(data->occupied & ~1ULL);
+        pcb_t* proc = queue_pop(data, level);
+        if (rq_push(&data->levels[0].ready, proc) < 0) {
+            printf("Error: out of memory queueing process %d\n", proc->pid);
+            continue;
         }
+        data->occupied |= 1ULL;
+        proc->priority = 0;
+        update_pcb_in_memory(proc); // Update PCB in memory
     }
-    q->tail = new_tail;
+    if (data->current && data->current->priority != 0) {
+        data->current->priority = 0;
+        data->ticks_used = 0;
+        update_pcb_in_memory(data->current); // Update PCB in memory
+    }
+    data->last_boost = sched_round;
+    log_trace("MLFQ: priority boost, all processes moved to level 0");
 }
 
 // MLFQ Methods
 static void mlfq_enqueue(Scheduler* sched, pcb_t* proc) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
-    int level = proc->priority;
-    if (level < 0 || level >= NUM_QUEUES) {
-        level = NUM_QUEUES - 1;
-        proc->priority = level;
-        update_pcb_in_memory(proc); // Update PCB in memory
-    }
-    proc->time_in_queue = 0; // Reset time in queue
-    update_pcb_in_memory(proc); // Update PCB in memory
-    queue_push(&data->levels[level], proc);
+    queue_push(data, proc_level(data, proc), proc);
 }
 
 static pcb_t* mlfq_next(Scheduler* sched) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
 
-    for (int i = 0; i < NUM_QUEUES; ++i){
-        mlfq_queue_t* q = &data->levels[i];
-        if (!queue_empty(q)) {
-            for (int j = q->head; j < q->tail; j++) {
-                q->queue[j]->time_in_queue++;
-                update_pcb_in_memory(q->queue[j]); // Update PCB in memory
-            }
-        }
+    // Waiting processes age by themselves (see pcb_wait_time)
+    if (data->boost_interval > 0 && sched_round - data->last_boost >= data->boost_interval) {
+        priority_boost(data);
     }
-    
-    // Check if any process is currently running
-    for (int i = 0; i < NUM_QUEUES; ++i) {
-        mlfq_queue_t* q = &data->levels[i];
-        if(q->current && q->current->state == RUNNING) {
-            // If current process is still running, return it
-            q->current->time_in_queue = 0; // Reset time in queue for the running process
-            update_pcb_in_memory(q->current); // Update PCB in memory
-            return q->current;
-        }
+
+    // Check if a process is currently running
+    if (data->current && data->current->state == RUNNING) {
+        // If current process is still running, return it
+        return data->current;
     }
 
-    for (int i = 0; i < NUM_QUEUES; ++i) {
-        mlfq_queue_t* q = &data->levels[i];
-        if (!queue_empty(q)) {
-            q->current = queue_pop(q);
-            q->ticks_used = 0;
-            q->current->time_in_queue = 0; // Reset time in queue for the running process
-            update_pcb_in_memory(q->current); // Update PCB in memory
-            return q->current;
-        }
+    int level = top_level(data);
+    if (level < 0) {
+        data->current = NULL;  // it finished; its slot may be reused
+        return NULL;
     }
-    return NULL;
+    data->current = queue_pop(data, level);
+    data->ticks_used = 0;
+    pcb_leave_queue(data->current); // Reset time in queue for the running process
+    return data->current;
 }
 
 static void mlfq_preempt(Scheduler* sched, pcb_t* proc) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
-    int level = proc->priority;
-    if (level < 0 || level >= NUM_QUEUES) {
-        level = NUM_QUEUES - 1;
-        proc->priority = level;
-        update_pcb_in_memory(proc); // Update PCB in memory
-    }
-    mlfq_queue_t* q = &data->levels[level];
+    mlfq_queue_t* q = &data->levels[proc_level(data, proc)];
 
-    q->ticks_used++;
+    data->ticks_used++;
 
-    if (q->ticks_used >= q->quantum) {
+    if (data->ticks_used >= q->quantum) {
         // Process used up quantum, demote if possible
-        if (proc->priority < NUM_QUEUES - 1) {
+        if (proc->priority < data->n_levels - 1) {
             proc->priority++;
             update_pcb_in_memory(proc); // Update PCB in memory
         }
         proc->state = READY;
         update_pcb_in_memory(proc); // Update PCB in memory
-        queue_push(&data->levels[proc->priority], proc);
-        q->current = NULL;
-        q->ticks_used = 0;
+        queue_push(data, proc->priority, proc);
+        data->current = NULL;
+        data->ticks_used = 0;
     } else {
         // Let it continue
-        q->current = proc;
-        // proc->state = READY;
-        // update_pcb_in_memory(proc); // Update PCB in memory
+        data->current = proc;
     }
-    
 }
 
 static void mlfq_destroy(Scheduler* sched) {
-    if (sched->data) free(sched->data);
+    mlfq_data_t* data = (mlfq_data_t*) sched->data;
+    if (data) {
+        if (data->levels) {
+            for (int i = 0; i < data->n_levels; ++i) rq_free(&data->levels[i].ready);
+            free(data->levels);
+        }
+        free(data);
+    }
     free(sched);
 }
 
 static void dequeue_mlfq(Scheduler* sched, pcb_t* proc) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
-    mlfq_queue_t* q = &data->levels[proc->priority];
-    // for (int i = 0; i < NUM_QUEUES; ++i) {
-    //     queue_remove(&data->levels[i], proc);
-    // }
+    mlfq_queue_t* q = &data->levels[proc_level(data, proc)];
     proc->time_in_queue = 0; // Reset time in queue
     update_pcb_in_memory(proc); // Update PCB in memory
-    q->ticks_used++;
-    if(q->ticks_used >= q->quantum){
-        if (proc->priority < NUM_QUEUES - 1){
+    data->ticks_used++;
+    if (data->ticks_used >= q->quantum) {
+        if (proc->priority < data->n_levels - 1) {
             proc->priority++;
             update_pcb_in_memory(proc); // Update PCB in memory
         }
-       }
-   q->current = NULL;
-   q->ticks_used = 0;
+    }
+    data->current = NULL;
+    data->ticks_used = 0;
 }
 static pcb_t* queue_mlfq(Scheduler* sched) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
-    pcb_t* queue[3];
-    int j=0;
-    for (int i = 0; i < NUM_QUEUES; i++) {
-        if (!queue_empty(&data->levels[i])) {
-            queue[j++] = data->levels[i].queue[data->levels[i].head];
-        }
-    }
-    if (j == 0) return NULL;
-    return queue[0];
+    int level = top_level(data);
+    if (level < 0) return NULL;
+    return rq_at(&data->levels[level].ready, 0);
 }
 static int queue_size_mlfq(Scheduler* sched) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
     int size = 0;
-    for (int i = 0; i < NUM_QUEUES; i++) {
-        size += data->levels[i].tail - data->levels[i].head;
+    for (uint64_t bits = data->occupied; bits; bits &= bits - 1) {
+        size += rq_size(&data->levels[__builtin_ctzll(bits)].ready);
     }
     return size;
 }
 static int queue_empty_mlfq(Scheduler* sched) {
     mlfq_data_t* data = (mlfq_data_t*) sched->data;
-    for (int i = 0; i < NUM_QUEUES; i++) {
-        if (!queue_empty(&data->levels[i])) {
-            return 0;
-        }
+    return data->occupied == 0;
+}
+static int next_timer_mlfq(Scheduler* sched) {
+    mlfq_data_t* data = (mlfq_data_t*) sched->data;
+    // The boost is due even when every queue is empty
+    return data->boost_interval > 0 ? data->last_boost + data->boost_interval : -1;
+}
+static pcb_t* steal_mlfq(Scheduler* sched) {
+    mlfq_data_t* data = (mlfq_data_t*) sched->data;
+    if (!data->occupied) return NULL;
+    // Give away the process that would wait longest: back of the lowest level
+    int level = 63 - __builtin_clzll(data->occupied);
+    run_queue_t* rq = &data->levels[level].ready;
+    pcb_t* proc = rq_pop_back(rq);
+    if (rq_empty(rq)) data->occupied &= ~(1ULL << level);
+    return proc;
+}
+static void purge_mlfq(Scheduler* sched, pcb_t* proc) {
+    mlfq_data_t* data = (mlfq_data_t*) sched->data;
+    for (uint64_t bits = data->occupied; bits; bits &= bits - 1) {
+        int level = __builtin_ctzll(bits);
+        run_queue_t* rq = &data->levels[level].ready;
+        rq_remove(rq, proc);
+        if (rq_empty(rq)) data->occupied &= ~(1ULL << level);
     }
-    return 1;
+}
+
+void mlfq_configure(const mlfq_config_t* config) {
+    default_config = *config;
 }
 
 Scheduler* create_mlfq_scheduler() {
+    return create_mlfq_scheduler_config(&default_config);
+}
+
+Scheduler* create_mlfq_scheduler_config(const mlfq_config_t* config) {
+    if (config->levels < 1 || config->levels > MLFQ_MAX_LEVELS) return NULL;
+
     Scheduler* sched = (Scheduler*) malloc(sizeof(Scheduler));
-    mlfq_data_t* data = (mlfq_data_t*) malloc(sizeof(mlfq_data_t));
+    mlfq_data_t* data = (mlfq_data_t*) calloc(1, sizeof(mlfq_data_t));
+    if (!sched || !data) {
+        free(data);
+        free(sched);
+        return NULL;
+    }
+    sched->data = data;
+    data->levels = calloc(config->levels, sizeof(mlfq_queue_t));
+    data->n_levels = config->levels;
+    data->boost_interval = config->boost_interval;
+    data->last_boost = sched_round;
+    if (!data->levels) {
+        data->n_levels = 0;
+        mlfq_destroy(sched);
+        return NULL;
+    }
 
-    for (int i = 0; i < NUM_QUEUES; ++i) {
-        queue_init(&data->levels[i], 1 << i); // quantum: 1, 2, 4, 8
+    // Unset quanta double the level above (1, 2, 4, 8 by default)
+    int quantum = 1;
+    for (int i = 0; i < data->n_levels; ++i) {
+        if (config->quanta[i] > 0) quantum = config->quanta[i];
+        else if (i > 0 && quantum <= INT_MAX / 2) quantum *= 2;
+        if (queue_init(&data->levels[i], quantum) < 0) {
+            mlfq_destroy(sched);
+            return NULL;
+        }
     }
 
     sched->type = SCHEDULER_MLFQ;
@@ -201,7 +257,9 @@ Scheduler* create_mlfq_scheduler() {
     sched->queue = queue_mlfq;
     sched->queue_size = queue_size_mlfq;
     sched->queue_empty = queue_empty_mlfq;
-    sched->data    = data;
+    sched->steal = steal_mlfq;
+    sched->next_timer = next_timer_mlfq;
+    sched->purge = purge_mlfq;
 
     return sched;
 }
@@ -2,7 +2,8 @@
 #include "../include/memory.h"
 #include "../include/semaphore.h"
 #include "../include/scheduler_interface.h"
-#include "../include/gui.h"
+#include "../include/io.h"
+#include "../include/compiler.h"
 // #include "../include/memory.h"
 // #include "../include/semaphore.h"
 // #include "../include/scheduler_interface.h"
@@ -10,8 +11,23 @@
 // External declaration of scheduler
 extern Scheduler* scheduler;
 
-void exec_print(pcb_t *proc, instruction_t *inst){
-    char* print_val = mem_read(proc->mem_low, proc->mem_high, inst->arg1);
+// Value of a variable operand, or NULL if it is unset (or not a variable)
+static char *var_value(pcb_t *proc, uint8_t kind, int32_t slot) {
+    if (kind != ARG_SLOT || slot < 0 || slot >= MAX_VARS) return NULL;
+    int idx = proc->mem_low + slot;
+    if (memory_pool[idx].name[0] == '\0') return NULL;
+    return (char*) mem_text(idx);
+}
+
+// Source-level name of an operand, for messages
+static const char *operand_name(const program_t *prog, uint8_t kind, int32_t val) {
+    if (kind == ARG_SLOT && val >= 0) return prog->vars[val];
+    if (kind == ARG_CONST) return prog->consts[val];
+    return "";
+}
+
+void exec_print(pcb_t *proc, const program_t *prog, const bc_insn_t *insn){
+    char* print_val = var_value(proc, insn->kind_a, insn->a);
     if (print_val) {
         // Create buffer for the log message with process ID prefix
         char log_buffer[512];
@@ -21,14 +37,14 @@ void exec_print(pcb_t *proc, instruction_t *inst){
         // Log an error if the variable isn't found
         char log_buffer[256];
         snprintf(log_buffer, sizeof(log_buffer), "Process %d: Error - Variable '%s' not found for printing", 
-                 proc->pid, inst->arg1);
+                 proc->pid, operand_name(prog, insn->kind_a, insn->a));
         log_message(log_buffer);
     }
 }
 
-void exec_assign(pcb_t *proc, instruction_t *inst){
+void exec_assign(pcb_t *proc, const program_t *prog, const bc_insn_t *insn){
     char value_buffer[100];
-    if (strcmp(inst->arg2, "input") == 0) {
+    if (insn->op == OP_ASSIGN_INPUT) {
         // Case 1: Input from user using GUI
         int input_value = get_program_input(proc->pid);
         
@@ -53,16 +69,14 @@ void exec_assign(pcb_t *proc, instruction_t *inst){
             log_message(log_msg);
         }
     }
-    else if(strncmp(inst->arg2, "readFile", 8) == 0){
+    else if(insn->op == OP_ASSIGN_READ_FILE){
         // Case 2: Nested instruction: readFile a
-        char filename_var[256];  // Allocate a buffer to hold the filename
-        sscanf(inst->arg2 + 9, "%255s", filename_var);
-
-        char *filename = mem_read(proc->mem_low, proc->mem_high, filename_var);
+        char *filename = var_value(proc, insn->kind_b, insn->b);
         if (!filename) {
             char log_msg[256];
             // Limit the variable name length to prevent buffer overflow
-            snprintf(log_msg, sizeof(log_msg), "Error: Variable '%.100s' not found in memory.", filename_var);
+            snprintf(log_msg, sizeof(log_msg), "Error: Variable '%.100s' not found in memory.",
+                     operand_name(prog, insn->kind_b, insn->b));
             log_message(log_msg);
             return;
         }
@@ -79,45 +93,44 @@ void exec_assign(pcb_t *proc, instruction_t *inst){
     }
     else {
         // Case 3: Direct value (e.g., number, string, another var)
-        char *mem_value = mem_read(proc->mem_low, proc->mem_high, inst->arg2);
+        char *mem_value = var_value(proc, insn->kind_b, insn->b);
         if (mem_value) {
             strncpy(value_buffer, mem_value, sizeof(value_buffer) - 1);
         } else {
-            strncpy(value_buffer, inst->arg2, sizeof(value_buffer) - 1);
+            strncpy(value_buffer, operand_name(prog, insn->kind_b, insn->b), sizeof(value_buffer) - 1);
         }
         value_buffer[sizeof(value_buffer) - 1] = '\0';
     }
-    // Store the final result in memory as variable `x`
-    for (int i = proc->mem_low; i <= proc->mem_low+2; i++) {
-        if (memory_pool[i].name[0] == '\0' || strcmp(memory_pool[i].name, inst->arg1) == 0) {
-            char log_msg[256];
-            snprintf(log_msg, sizeof(log_msg), "Assigning %s to %s", value_buffer, inst->arg1);
-            log_message(log_msg);
-            mem_write(i, inst->arg1, value_buffer);
-            return;
-        }
+    // Store the final result in the variable's slot
+    const char *var = prog->vars[insn->a];
+    if (insn->a < MAX_VARS) {
+        char log_msg[256];
+        snprintf(log_msg, sizeof(log_msg), "Assigning %s to %s", value_buffer, var);
+        log_message(log_msg);
+        mem_write(proc->mem_low + insn->a, (char*) var, value_buffer);
+        return;
     }
     
     char log_msg[256];
-    snprintf(log_msg, sizeof(log_msg), "Error: No space to assign variable '%s'", inst->arg1);
+    snprintf(log_msg, sizeof(log_msg), "Error: No space to assign variable '%s'", var);
     log_message(log_msg);
 }
 
-void exec_write_file(pcb_t *proc, instruction_t *inst) {
+void exec_write_file(pcb_t *proc, const program_t *prog, const bc_insn_t *insn) {
     // Wait for file resource
-    sem_wait(RESOURCE_FILE, proc, scheduler);
+    sem_wait_id(RESOURCE_FILE_ID, proc, scheduler);
     
-    char* file_name = mem_read(proc->mem_low, proc->mem_high, inst->arg1);
+    char* file_name = var_value(proc, insn->kind_a, insn->a);
     if (!file_name) {
         log_message("Error: File name variable not found in memory");
-        sem_signal(RESOURCE_FILE, scheduler);
+        sem_signal_id(RESOURCE_FILE_ID, scheduler);
         return;
     }
     
-    char* write_val = mem_read(proc->mem_low, proc->mem_high, inst->arg2);
+    char* write_val = var_value(proc, insn->kind_b, insn->b);
     if (!write_val) {
         log_message("Error: Content variable not found in memory");
-        sem_signal(RESOURCE_FILE, scheduler);
+        sem_signal_id(RESOURCE_FILE_ID, scheduler);
         return;
     }
     
@@ -135,52 +148,46 @@ void exec_write_file(pcb_t *proc, instruction_t *inst) {
     }
     
     // Release file resource
-    sem_signal(RESOURCE_FILE, scheduler);
+    sem_signal_id(RESOURCE_FILE_ID, scheduler);
 }
 
-void exec_read_file(pcb_t *proc, instruction_t *inst) {
+void exec_read_file(pcb_t *proc, const program_t *prog, const bc_insn_t *insn) {
+    const char *path = prog->consts[insn->a];
+
     // Wait for file resource
-    sem_wait(RESOURCE_FILE, proc, scheduler);
+    sem_wait_id(RESOURCE_FILE_ID, proc, scheduler);
     
     // Get file content through GUI
-    char* content = get_file_content(inst->arg1);
+    char* content = get_file_content(path);
     
     if (content[0] != '\0') { // If content was successfully read
-        // Find a free memory location to store the file content
-        int stored = 0;
-        for (int i = proc->mem_low; i <= proc->mem_high; i++) {
-            if (memory_pool[i].name[0] == '\0') {
-                // Store file content in a variable named "fileContent"
-                mem_write(i, "fileContent", content);
-                stored = 1;
-                
-                char buffer[256];
-                snprintf(buffer, sizeof(buffer), "Process %d read file %s into memory", proc->pid, inst->arg1);
-                log_message(buffer);
-                break;
-            }
-        }
-        
-        if (!stored) {
+        // Store file content in the variable named "fileContent"
+        if (insn->b >= 0 && insn->b < MAX_VARS) {
+            mem_write(proc->mem_low + insn->b, FILE_CONTENT_VAR, content);
+            
+            char buffer[256];
+            snprintf(buffer, sizeof(buffer), "Process %d read file %s into memory", proc->pid, path);
+            log_message(buffer);
+        } else {
             char buffer[256];
             snprintf(buffer, sizeof(buffer), "Process %d: No memory available to store file content", proc->pid);
             log_message(buffer);
         }
     } else {
         char buffer[256];
-        snprintf(buffer, sizeof(buffer), "Process %d failed to read file %s", proc->pid, inst->arg1);
+        snprintf(buffer, sizeof(buffer), "Process %d failed to read file %s", proc->pid, path);
         log_message(buffer);
     }
     
     // Release file resource
-    sem_signal(RESOURCE_FILE, scheduler);
+    sem_signal_id(RESOURCE_FILE_ID, scheduler);
 }
-void exec_print_from_to(pcb_t *proc, instruction_t *inst){
-    char *val1 = mem_read(proc->mem_low, proc->mem_high, inst->arg1);
-    char *val2 = mem_read(proc->mem_low, proc->mem_high, inst->arg2);
-    // If val1 or val2 aren't found, assume direct numbers
-    int from = val1 ? atoi(val1) : atoi(inst->arg1);
-    int to   = val2 ? atoi(val2) : atoi(inst->arg2);
+void exec_print_from_to(pcb_t *proc, const program_t *prog, const bc_insn_t *insn){
+    char *val1 = var_value(proc, insn->kind_a, insn->a);
+    char *val2 = var_value(proc, insn->kind_b, insn->b);
+    // Unset variables count as 0, like non-numeric literals
+    int from = val1 ? atoi(val1) : (insn->kind_a == ARG_IMM ? insn->a : 0);
+    int to   = val2 ? atoi(val2) : (insn->kind_b == ARG_IMM ? insn->b : 0);
     
     // Log the range
     char range_msg[256];
@@ -208,36 +215,96 @@ void exec_print_from_to(pcb_t *proc, instruction_t *inst){
     log_message(sequence);
 }
 
-char * state_type_to_string(proc_state_t state) {
-    switch (state) {
-        case NEW: return "NEW";
-        case READY: return "READY";
-        case RUNNING: return "RUNNING";
-        case BLOCKED: return "BLOCKED";
-        case TERMINATED: return "TERMINATED";
-        default: return "UNKNOWN";
+void exec_semaphore(pcb_t *proc, const program_t *prog, const bc_insn_t *insn) {
+    if (insn->kind_a != ARG_IMM) {
+        char buffer[256];
+        snprintf(buffer, sizeof(buffer), "Process %d: Error - out of memory for resource '%s'",
+                 proc->pid, prog->consts[insn->a]);
+        log_message(buffer);
+        return;
     }
+    if (insn->op == OP_SEM_WAIT) sem_wait_id(insn->a, proc, scheduler);
+    else sem_signal_id(insn->a, scheduler);
 }
 
-// Update the PCB in memory with the new values
-// This function assumes that the PCB is stored in memory and that
-// the memory pool is already initialized
+// Labels for the "state" word of a PCB, indexed by proc_state_t
+const char *const proc_state_names[] = {
+    "NEW", "READY", "RUNNING", "BLOCKED", "TERMINATED"
+};
+
+char * state_type_to_string(proc_state_t state) {
+    if (state < NEW || state > TERMINATED) return "UNKNOWN";
+    return (char*) proc_state_names[state];
+}
+
+// PCBs changed during the current tick, linked through next_dirty
+static pcb_t *dirty_pcbs = NULL;
+
+// Record that the PCB changed. The memory copy is refreshed once, by
+// flush_pcb_updates() at the end of the tick, however often this is called.
 void update_pcb_in_memory(pcb_t *proc) {
-    int idx = proc->pcb_index;
-    char str[32];
+    if (proc->dirty) return;
+    proc->dirty = 1;
+    proc->next_dirty = dirty_pcbs;
+    dirty_pcbs = proc;
+}
+
+// Write back the mirrored fields that actually changed.
+// This function assumes that the PCB is stored in memory and that
+// the memory pool is already initialized. Fields are stored as native
+// integers; they are only formatted when someone reads them as text.
+void flush_pcb_updates(void) {
+    while (dirty_pcbs) {
+        pcb_t *proc = dirty_pcbs;
+        mem_word_t *w = &memory_pool[proc->pcb_index];
 
-    mem_write(idx + 1, "state", state_type_to_string(proc->state));
+        if (w[1].ival != (int) proc->state)
+            mem_write_enum(proc->pcb_index + 1, "state", proc->state, proc_state_names);
+        if (w[2].ival != proc->priority)
+            mem_write_int(proc->pcb_index + 2, "priority", proc->priority);
+        if (w[3].ival != proc->pc)
+            mem_write_int(proc->pcb_index + 3, "pc", proc->pc);
+        if (proc->enqueue_tick >= 0) {
+            // Waiting: the word counts up by itself from the enqueue stamp
+            if (w[7].type != MEM_ELAPSED || w[7].ival != proc->enqueue_tick)
+                mem_write_elapsed(proc->pcb_index + 7, "time_in_queue", proc->enqueue_tick, &sched_round);
+        } else if (w[7].type != MEM_INT || w[7].ival != proc->time_in_queue) {
+            mem_write_int(proc->pcb_index + 7, "time_in_queue", proc->time_in_queue);
+        }
+
+        dirty_pcbs = proc->next_dirty;
+        proc->next_dirty = NULL;
+        proc->dirty = 0;
+    }
+}
+
+int sched_round = 0;
 
-    snprintf(str, sizeof str, "%d", proc->priority);
-    mem_write(idx + 2, "priority", str);
+void pcb_enter_queue(pcb_t *proc) {
+    proc->enqueue_tick = sched_round;
+    proc->time_in_queue = 0;
+    update_pcb_in_memory(proc);
+}
 
-    memset(str, 0, sizeof str); // Clear the buffer
-    snprintf(str, sizeof str, "%d", proc->pc);
-    mem_write(idx + 3, "pc", str);
+void pcb_leave_queue(pcb_t *proc) {
+    proc->enqueue_tick = -1;
+    proc->time_in_queue = 0;
+    update_pcb_in_memory(proc);
+}
 
-    memset(str, 0, sizeof str); // Clear the buffer
-    snprintf(str, sizeof str, "%d", proc->time_in_queue);
-    mem_write(idx + 7, "time_in_queue", str);
+int pcb_wait_time(const pcb_t *proc) {
+    if (proc->enqueue_tick >= 0) return sched_round - proc->enqueue_tick;
+    return proc->time_in_queue;
+}
+
+// Forget pending write-backs (the memory they target has been wiped)
+void discard_pcb_updates(void) {
+    while (dirty_pcbs) {
+        pcb_t *proc = dirty_pcbs;
+        dirty_pcbs = proc->next_dirty;
+        proc->next_dirty = NULL;
+        proc->dirty = 0;
+    }
 }
 
 // void exec_semWait(pcb_t *proc, instruction_t *inst, Scheduler* scheduler){
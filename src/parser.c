@@ -3,17 +3,18 @@
 #include <string.h>
 #include "../include/parser.h" 
 
-instruction_t* parse_program(char *path) {
-    if (!path) return NULL;
-    
-    instruction_t* inst = malloc(sizeof(instruction_t));
-    if (!inst) return NULL;
-    
-    char *tok = strtok(path, " \t\n");
-    if (!tok) {
-        free(inst);
-        return NULL;
-    }
+int decode_instruction(const char *line, instruction_t *inst) {
+    char buf[MAX_LINE_LEN];
+    char *save = NULL;
+
+    memset(inst, 0, sizeof(*inst));
+    inst->type = INST_INVALID;
+    if (!line) return -1;
+    strncpy(buf, line, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    char *tok = strtok_r(buf, " \t\n", &save);
+    if (!tok) return -1;
     
     // Parse the instruction type
     if (strcmp(tok, "assign") == 0) inst->type = INST_ASSIGN;
@@ -23,21 +24,26 @@ instruction_t* parse_program(char *path) {
     else if (strcmp(tok, "printFromTo") == 0) inst->type = INST_PRINT_FROM_TO;
     else if (strcmp(tok, "semWait") == 0) inst->type = INST_SEM_WAIT;
     else if (strcmp(tok, "semSignal") == 0) inst->type = INST_SEM_SIGNAL;
-    else {
-        free(inst);
-        return NULL;
-    }
+    else return -1;
     
     // Read arguments
-    char *a1 = strtok(NULL, " \n");
-    char *a2 = strtok(NULL, "\n");
+    char *a1 = strtok_r(NULL, " \n", &save);
+    char *a2 = strtok_r(NULL, "\n", &save);
     
     if (a1) strncpy(inst->arg1, a1, sizeof(inst->arg1)-1);
-    else inst->arg1[0] = '\0';
-    
     if (a2) strncpy(inst->arg2, a2, sizeof(inst->arg2)-1);
-    else inst->arg2[0] = '\0';
     
+    return 0;
+}
+
+instruction_t* parse_program(char *path) {
+    instruction_t* inst = malloc(sizeof(instruction_t));
+    if (!inst) return NULL;
+    
+    if (decode_instruction(path, inst) < 0) {
+        free(inst);
+        return NULL;
+    }
     return inst;
 }
 
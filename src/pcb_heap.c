@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include "../include/pcb_heap.h"
+
+int ph_init(pcb_heap_t *h, int capacity) {
+    h->cap = capacity > 8 ? capacity : 8;
+    h->items = malloc(h->cap * sizeof(pcb_heap_entry_t));
+    if (!h->items) return -1;
+    h->size = 0;
+    h->next_seq = 0;
+    return 0;
+}
+
+void ph_free(pcb_heap_t *h) {
+    free(h->items);
+    h->items = NULL;
+    h->size = h->cap = 0;
+}
+
+static int ph_less(const pcb_heap_entry_t *a, const pcb_heap_entry_t *b) {
+    if (a->key != b->key) return a->key < b->key;
+    return (int) (a->seq - b->seq) < 0;  // wraps safely
+}
+
+int ph_push(pcb_heap_t *h, long key, pcb_t *proc) {
+    if (h->size == h->cap) {
+        pcb_heap_entry_t *grown = realloc(h->items, 2 * h->cap * sizeof(pcb_heap_entry_t));
+        if (!grown) return -1;
+        h->items = grown;
+        h->cap *= 2;
+    }
+
+    // Sift up from the new leaf
+    pcb_heap_entry_t e = { key, h->next_seq++, proc };
+    int i = h->size++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!ph_less(&e, &h->items[parent])) break;
+        h->items[i] = h->items[parent];
+        i = parent;
+    }
+    h->items[i] = e;
+    return 0;
+}
+
+// Place `e` at index i, or below it, so that the subtree is a heap again
+static void ph_sift_down(pcb_heap_t *h, int i, pcb_heap_entry_t e) {
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && ph_less(&h->items[child + 1], &h->items[child])) child++;
+        if (!ph_less(&h->items[child], &e)) break;
+        h->items[i] = h->items[child];
+        i = child;
+    }
+    h->items[i] = e;
+}
+
+pcb_t* ph_pop(pcb_heap_t *h) {
+    if (h->size == 0) return NULL;
+    pcb_t *top = h->items[0].proc;
+
+    // Sift the last leaf down from the root
+    pcb_heap_entry_t e = h->items[--h->size];
+    if (h->size > 0) ph_sift_down(h, 0, e);
+    return top;
+}
+
+int ph_remove(pcb_heap_t *h, pcb_t *proc) {
+    int kept = 0;
+    for (int i = 0; i < h->size; i++) {
+        if (h->items[i].proc != proc) h->items[kept++] = h->items[i];
+    }
+    int removed = h->size - kept;
+    h->size = kept;
+    if (removed > 0) {
+        // Rebuild bottom-up
+        for (int i = kept / 2 - 1; i >= 0; i--) ph_sift_down(h, i, h->items[i]);
+    }
+    return removed;
+}
@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/proc_table.h"
+
+static pcb_t **slabs = NULL;
+static int n_slabs = 0;
+static int n_slots = 0;        // slots ever handed out (high-water mark)
+static int n_live = 0;
+static pcb_t *free_list = NULL;
+
+// PID bitmap, bit set = in use, and the first word that may have a free bit
+static uint64_t *pid_bits = NULL;
+static int pid_words = 0;
+static int pid_hint = 0;
+
+// PID -> PCB, open addressing with linear probing. Capacity is a power of
+// two kept at least twice the number of entries.
+static pcb_t **pid_index = NULL;
+static int index_cap = 0;
+static int index_used = 0;
+
+static unsigned pid_hash(int pid) {
+    return (unsigned) pid * 2654435761u;
+}
+
+static int pid_taken(int pid) {
+    return pid / 64 < pid_words && (pid_bits[pid / 64] >> (pid % 64) & 1);
+}
+
+// Bitmap words up to (and including) the one for `pid`; -1 if out of memory
+static int pid_bits_reserve(int pid) {
+    int need = pid / 64 + 1;
+    if (need <= pid_words) return 0;
+    int words = pid_words ? pid_words : 1;
+    while (words < need) words *= 2;
+    uint64_t *grown = realloc(pid_bits, words * sizeof(uint64_t));
+    if (!grown) return -1;
+    memset(grown + pid_words, 0, (words - pid_words) * sizeof(uint64_t));
+    pid_bits = grown;
+    pid_words = words;
+    return 0;
+}
+
+// Lowest free PID from 1, or where the bitmap would grow to
+static int pid_lowest_free(void) {
+    for (int w = pid_hint; w < pid_words; w++) {
+        uint64_t free_bits = ~pid_bits[w];
+        if (w == 0) free_bits &= ~1ULL;  // PID 0 only when asked for
+        if (free_bits) {
+            pid_hint = w;
+            return w * 64 + __builtin_ctzll(free_bits);
+        }
+    }
+    pid_hint = pid_words;
+    return pid_words ? pid_words * 64 : 1;
+}
+
+static void index_insert(pcb_t *proc) {
+    unsigned mask = index_cap - 1;
+    unsigned i = pid_hash(proc->pid) & mask;
+    while (pid_index[i]) i = (i + 1) & mask;
+    pid_index[i] = proc;
+    index_used++;
+}
+
+// Room for one more entry; -1 if out of memory
+static int index_reserve(void) {
+    if (2 * (index_used + 1) <= index_cap) return 0;
+    int cap = index_cap ? 2 * index_cap : 64;
+    pcb_t **old = pid_index;
+    int old_cap = index_cap;
+    pid_index = calloc(cap, sizeof(pcb_t*));
+    if (!pid_index) {
+        pid_index = old;
+        return -1;
+    }
+    index_cap = cap;
+    index_used = 0;
+    for (int i = 0; i < old_cap; i++) {
+        if (old[i]) index_insert(old[i]);
+    }
+    free(old);
+    return 0;
+}
+
+static void index_remove(int pid) {
+    if (index_cap == 0) return;
+    unsigned mask = index_cap - 1;
+    unsigned i = pid_hash(pid) & mask;
+    while (pid_index[i] && pid_index[i]->pid != pid) i = (i + 1) & mask;
+    if (!pid_index[i]) return;
+
+    // Shift later entries of the probe run back so no lookup stops early
+    unsigned hole = i;
+    for (unsigned j = (i + 1) & mask; pid_index[j]; j = (j + 1) & mask) {
+        unsigned home = pid_hash(pid_index[j]->pid) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            pid_index[hole] = pid_index[j];
+            hole = j;
+        }
+    }
+    pid_index[hole] = NULL;
+    index_used--;
+}
+
+pcb_t* proc_lookup(int pid) {
+    if (pid < 0 || index_cap == 0) return NULL;
+    unsigned mask = index_cap - 1;
+    for (unsigned i = pid_hash(pid) & mask; pid_index[i]; i = (i + 1) & mask) {
+        if (pid_index[i]->pid == pid) return pid_index[i];
+    }
+    return NULL;
+}
+
+int proc_assign_pid(pcb_t *proc, int preferred) {
+    int pid = preferred;
+    if (pid < 0 || pid >= PID_MAX || pid_taken(pid)) pid = pid_lowest_free();
+    if (pid >= PID_MAX) return -1;
+    if (pid_bits_reserve(pid) < 0 || index_reserve() < 0) return -1;
+
+    pid_bits[pid / 64] |= 1ULL << (pid % 64);
+    proc->pid = pid;
+    index_insert(proc);
+    return pid;
+}
+
+static pcb_t* slot_at(int slot) {
+    return &slabs[slot / PROC_SLAB_SIZE][slot % PROC_SLAB_SIZE];
+}
+
+// Room for one more slot past the high-water mark; -1 if out of memory
+static int grow(void) {
+    if (n_slots < n_slabs * PROC_SLAB_SIZE) return 0;
+    pcb_t **grown = realloc(slabs, (n_slabs + 1) * sizeof(pcb_t*));
+    if (!grown) return -1;
+    slabs = grown;
+    slabs[n_slabs] = calloc(PROC_SLAB_SIZE, sizeof(pcb_t));
+    if (!slabs[n_slabs]) return -1;
+    n_slabs++;
+    return 0;
+}
+
+pcb_t* proc_alloc(void) {
+    pcb_t *proc;
+    int slot;
+    if (free_list) {
+        proc = free_list;
+        free_list = proc->next_free;
+        slot = proc->slot;
+    } else {
+        if (grow() < 0) return NULL;
+        slot = n_slots++;
+        proc = slot_at(slot);
+    }
+    memset(proc, 0, sizeof(pcb_t));
+    proc->pid = -1;
+    proc->slot = slot;
+    proc->in_use = 1;
+    n_live++;
+    return proc;
+}
+
+void proc_release(pcb_t *proc) {
+    if (!proc || !proc->in_use) return;
+    if (proc->pid >= 0) {
+        index_remove(proc->pid);
+        pid_bits[proc->pid / 64] &= ~(1ULL << (proc->pid % 64));
+        if (proc->pid / 64 < pid_hint) pid_hint = proc->pid / 64;
+    }
+    proc->in_use = 0;
+    proc->next_free = free_list;
+    free_list = proc;
+    n_live--;
+}
+
+pcb_t* proc_first(void) {
+    for (int slot = 0; slot < n_slots; slot++) {
+        if (slot_at(slot)->in_use) return slot_at(slot);
+    }
+    return NULL;
+}
+
+pcb_t* proc_next(const pcb_t *proc) {
+    for (int slot = proc->slot + 1; slot < n_slots; slot++) {
+        if (slot_at(slot)->in_use) return slot_at(slot);
+    }
+    return NULL;
+}
+
+int proc_count(void) {
+    return n_live;
+}
+
+void proc_table_reset(void) {
+    for (int i = 0; i < n_slabs; i++) free(slabs[i]);
+    free(slabs);
+    slabs = NULL;
+    n_slabs = n_slots = n_live = 0;
+    free_list = NULL;
+    free(pid_bits);
+    free(pid_index);
+    pid_bits = NULL;
+    pid_index = NULL;
+    pid_words = pid_hint = 0;
+    index_cap = index_used = 0;
+}
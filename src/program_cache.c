@@ -0,0 +1,268 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/program_cache.h"
+#include "../include/parser.h"
+
+#define IMAGE_MAGIC   0x474d4950u   // "PIMG"
+#define IMAGE_VERSION 1
+
+// On-disk image: this header, then the code, vars, consts, line_off and
+// text sections, each starting on an 8-byte boundary
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t insn_size;      // sizeof(bc_insn_t) of the writer
+    uint32_t n_code;
+    uint32_t n_vars;
+    uint32_t n_consts;
+    uint32_t text_len;
+    uint32_t reserved;
+    int64_t  src_size;       // source file the image was compiled from
+    int64_t  src_mtime;
+    int64_t  src_mtime_nsec;
+    char     src_path[256];
+    uint64_t off_code, off_vars, off_consts, off_line_off, off_text;
+    uint64_t image_len;
+} image_header_t;
+
+static char *cache_dir = NULL;
+
+void program_cache_set_dir(const char *dir) {
+    free(cache_dir);
+    cache_dir = dir ? strdup(dir) : NULL;
+}
+
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~(uint64_t) 7;
+}
+
+// Image file for `path`: <dir>/<FNV-1a of the path>.img
+static void image_path(const char *path, char *out, size_t len) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const char *s = path; *s; s++) {
+        h ^= (unsigned char) *s;
+        h *= 1099511628211ULL;
+    }
+    snprintf(out, len, "%s/%016llx.img", cache_dir, (unsigned long long) h);
+}
+
+// Fill in the section layout for `prog`
+static void layout(image_header_t *hdr, const program_t *prog) {
+    hdr->n_code = prog->n_code;
+    hdr->n_vars = prog->n_vars;
+    hdr->n_consts = prog->n_consts;
+    hdr->text_len = prog->text_len;
+    hdr->off_code = align8(sizeof(image_header_t));
+    hdr->off_vars = align8(hdr->off_code + (uint64_t) prog->n_code * sizeof(bc_insn_t));
+    hdr->off_consts = align8(hdr->off_vars + (uint64_t) prog->n_vars * sizeof(*prog->vars));
+    hdr->off_line_off = align8(hdr->off_consts + (uint64_t) prog->n_consts * sizeof(*prog->consts));
+    hdr->off_text = align8(hdr->off_line_off + (uint64_t) prog->n_code * sizeof(uint32_t));
+    hdr->image_len = hdr->off_text + prog->text_len;
+}
+
+static int operand_valid(const program_t *prog, uint8_t kind, int32_t val) {
+    switch (kind) {
+        case ARG_NONE:
+        case ARG_IMM:   return 1;
+        case ARG_SLOT:  return val >= 0 && val < prog->n_vars;
+        case ARG_CONST: return val >= 0 && val < prog->n_consts;
+        default:        return 0;
+    }
+}
+
+// The sections hold what a compiled program would: operands index into
+// their pools, and every name and source line ends inside its section
+static int image_valid(const program_t *prog) {
+    if (prog->n_code > 0 && (prog->text_len == 0 || prog->text[prog->text_len - 1] != '\0')) return 0;
+    for (int i = 0; i < prog->n_code; i++) {
+        const bc_insn_t *insn = &prog->code[i];
+        if (insn->op > OP_INVALID || prog->line_off[i] >= prog->text_len ||
+            !operand_valid(prog, insn->kind_a, insn->a) ||
+            !operand_valid(prog, insn->kind_b, insn->b)) return 0;
+    }
+    for (int i = 0; i < prog->n_vars; i++) {
+        if (!memchr(prog->vars[i], '\0', sizeof(prog->vars[i]))) return 0;
+    }
+    for (int i = 0; i < prog->n_consts; i++) {
+        if (!memchr(prog->consts[i], '\0', sizeof(prog->consts[i]))) return 0;
+    }
+    return 1;
+}
+
+// Map a cached image, or NULL if there is none, it is out of date or it
+// does not hold a valid program
+static program_t *image_load(const char *img, const char *path, const struct stat *st) {
+    int fd = open(img, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat ist;
+    if (fstat(fd, &ist) < 0 || (size_t) ist.st_size < sizeof(image_header_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    // Private writable mapping: program_link() patches resource IDs in place
+    size_t len = ist.st_size;
+    void *base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+
+    const image_header_t *hdr = base;
+    image_header_t want = *hdr;
+    program_t shape = { .n_code = hdr->n_code, .n_vars = hdr->n_vars,
+                        .n_consts = hdr->n_consts, .text_len = hdr->text_len };
+    layout(&want, &shape);
+
+    if (hdr->magic != IMAGE_MAGIC || hdr->version != IMAGE_VERSION ||
+        hdr->insn_size != sizeof(bc_insn_t) || hdr->image_len != len ||
+        memcmp(hdr, &want, sizeof(want)) != 0 ||
+        hdr->src_size != (int64_t) st->st_size ||
+        hdr->src_mtime != (int64_t) st->st_mtim.tv_sec ||
+        hdr->src_mtime_nsec != (int64_t) st->st_mtim.tv_nsec ||
+        strncmp(hdr->src_path, path, sizeof(hdr->src_path)) != 0) {
+        munmap(base, len);
+        return NULL;
+    }
+
+    program_t *prog = calloc(1, sizeof(program_t));
+    if (!prog) {
+        munmap(base, len);
+        return NULL;
+    }
+    char *b = base;
+    prog->code = (bc_insn_t*) (b + hdr->off_code);
+    prog->n_code = hdr->n_code;
+    prog->vars = (char (*)[32]) (b + hdr->off_vars);
+    prog->n_vars = hdr->n_vars;
+    prog->consts = (char (*)[32]) (b + hdr->off_consts);
+    prog->n_consts = hdr->n_consts;
+    prog->line_off = (uint32_t*) (b + hdr->off_line_off);
+    prog->text = b + hdr->off_text;
+    prog->text_len = hdr->text_len;
+    prog->image = base;
+    prog->image_len = len;
+    if (!image_valid(prog)) {
+        free(prog);
+        munmap(base, len);
+        return NULL;
+    }
+    return prog;
+}
+
+// Write the (unlinked) program next to a temp name and rename it into place,
+// so a concurrent reader never sees half an image
+static void image_store(const char *img, const char *path, const struct stat *st,
+                        const program_t *prog) {
+    if (strlen(path) >= sizeof(((image_header_t*) 0)->src_path)) return;
+
+    image_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = IMAGE_MAGIC;
+    hdr.version = IMAGE_VERSION;
+    hdr.insn_size = sizeof(bc_insn_t);
+    hdr.src_size = st->st_size;
+    hdr.src_mtime = st->st_mtim.tv_sec;
+    hdr.src_mtime_nsec = st->st_mtim.tv_nsec;
+    strncpy(hdr.src_path, path, sizeof(hdr.src_path) - 1);
+    layout(&hdr, prog);
+
+    char *buf = calloc(1, hdr.image_len);
+    if (!buf) return;
+    memcpy(buf, &hdr, sizeof(hdr));
+    memcpy(buf + hdr.off_code, prog->code, prog->n_code * sizeof(bc_insn_t));
+    memcpy(buf + hdr.off_vars, prog->vars, prog->n_vars * sizeof(*prog->vars));
+    memcpy(buf + hdr.off_consts, prog->consts, prog->n_consts * sizeof(*prog->consts));
+    memcpy(buf + hdr.off_line_off, prog->line_off, prog->n_code * sizeof(uint32_t));
+    memcpy(buf + hdr.off_text, prog->text, prog->text_len);
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.%d.tmp", img, (int) getpid());
+    FILE *f = fopen(tmp, "wb");
+    if (f) {
+        int ok = fwrite(buf, 1, hdr.image_len, f) == hdr.image_len;
+        ok = (fclose(f) == 0) && ok;
+        if (!ok || rename(tmp, img) != 0) {
+            printf("Could not write program cache %s\n", img);
+            remove(tmp);
+        }
+    }
+    free(buf);
+}
+
+// Read the source once: keep every line's text and decode it, then compile
+static program_t *compile_file(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return NULL;
+
+    int cap = 16, n = 0;
+    size_t text_cap = 1024, text_len = 0;
+    instruction_t *insts = malloc(cap * sizeof(instruction_t));
+    uint32_t *line_off = malloc(cap * sizeof(uint32_t));
+    char *text = malloc(text_cap);
+    program_t *prog = NULL;
+    char line[MAX_LINE_LEN];
+
+    if (!insts || !line_off || !text) goto out;
+    while (fgets(line, sizeof(line), f)) {
+        size_t len = strlen(line) + 1;
+        if (n == cap) {
+            cap *= 2;
+            instruction_t *ni = realloc(insts, cap * sizeof(instruction_t));
+            if (ni) insts = ni;
+            uint32_t *nl = realloc(line_off, cap * sizeof(uint32_t));
+            if (nl) line_off = nl;
+            if (!ni || !nl) goto out;
+        }
+        if (text_len + len > text_cap) {
+            while (text_len + len > text_cap) text_cap *= 2;
+            char *nt = realloc(text, text_cap);
+            if (!nt) goto out;
+            text = nt;
+        }
+        memcpy(text + text_len, line, len);
+        line_off[n] = text_len;
+        text_len += len;
+        decode_instruction(line, &insts[n]);
+        n++;
+    }
+
+    prog = compile_program(insts, n);
+    if (prog) {
+        prog->text = text;
+        prog->line_off = line_off;
+        prog->text_len = text_len;
+        text = NULL;
+        line_off = NULL;
+    }
+out:
+    fclose(f);
+    free(insts);
+    free(line_off);
+    free(text);
+    return prog;
+}
+
+program_t* program_cache_load(const char *path) {
+    struct stat st;
+    if (stat(path, &st) < 0) return NULL;
+
+    char img[512];
+    program_t *prog = NULL;
+    if (cache_dir) {
+        image_path(path, img, sizeof(img));
+        prog = image_load(img, path, &st);
+    }
+    if (!prog) {
+        prog = compile_file(path);
+        if (!prog) return NULL;
+        if (cache_dir) image_store(img, path, &st, prog);
+    }
+    program_link(prog);
+    return prog;
+}
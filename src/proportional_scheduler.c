@@ -0,0 +1,189 @@
+// src/proportional_scheduler.c
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/proportional_scheduler.h"
+#include "../include/keyed_heap_scheduler.h"
+
+static unsigned long lottery_seed = 1;
+
+void lottery_set_seed(unsigned long seed) {
+    lottery_seed = seed;
+}
+
+// --- Lottery ---
+
+typedef struct {
+    pcb_t** pool;        // ready processes, in no particular order
+    int size;
+    int cap;
+    long total_tickets;  // tickets held by the pool
+    uint64_t rng;        // xorshift64* state, never 0
+    pcb_t* current;      // currently running process
+} lottery_data_t;
+
+static uint64_t lottery_rand(lottery_data_t *lt) {
+    lt->rng ^= lt->rng >> 12;
+    lt->rng ^= lt->rng << 25;
+    lt->rng ^= lt->rng >> 27;
+    return lt->rng * 0x2545F4914F6CDD1DULL;
+}
+
+static void enqueue_lottery(Scheduler *self, pcb_t *proc) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    if (lt->size == lt->cap) {
+        int cap = lt->cap ? 2 * lt->cap : 8;
+        pcb_t **grown = realloc(lt->pool, cap * sizeof(pcb_t*));
+        if (!grown) {
+            printf("Error: out of memory queueing process %d\n", proc->pid);
+            return;
+        }
+        lt->pool = grown;
+        lt->cap = cap;
+    }
+    lt->pool[lt->size++] = proc;
+    lt->total_tickets += proc->tickets;
+    proc->state = READY;
+    pcb_enter_queue(proc); // Wait time counts from now
+}
+
+static pcb_t* next_lottery(Scheduler *self) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    if (lt->size == 0) {
+        lt->current = NULL;  // it finished; its slot may be reused
+        return NULL;
+    }
+
+    // Walk the pool until the drawn ticket is reached
+    long winner = (long) (lottery_rand(lt) % (uint64_t) lt->total_tickets);
+    int i = 0;
+    while (winner >= lt->pool[i]->tickets) {
+        winner -= lt->pool[i]->tickets;
+        i++;
+    }
+
+    lt->current = lt->pool[i];
+    lt->pool[i] = lt->pool[--lt->size];
+    lt->total_tickets -= lt->current->tickets;
+    pcb_leave_queue(lt->current); // Reset time in queue for the running process
+    return lt->current;
+}
+
+static void preempt_lottery(Scheduler *self, pcb_t *proc) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    // Back into the draw for the next tick
+    proc->state = READY;
+    update_pcb_in_memory(proc); // Update PCB in memory
+    lt->current = NULL;
+    enqueue_lottery(self, proc);
+}
+
+static void destroy_lottery(Scheduler *self) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    free(lt->pool);
+    free(self->data);
+    free(self);
+}
+
+static void dequeue_lottery(Scheduler* sched, pcb_t* proc) {
+    lottery_data_t *lt = (lottery_data_t*) sched->data;
+    // Only the running process blocks itself, and it is not in the pool
+    if (lt->current == proc) lt->current = NULL;
+}
+static pcb_t* queue_lottery(Scheduler *self) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    return lt->size ? lt->pool[0] : NULL;
+}
+static int queue_size_lottery(Scheduler *self) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    return lt->size;
+}
+static int queue_empty_lottery(Scheduler *self) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    return lt->size == 0;
+}
+static pcb_t* steal_lottery(Scheduler *self) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    if (lt->size == 0) return NULL;
+    pcb_t *proc = lt->pool[--lt->size];
+    lt->total_tickets -= proc->tickets;
+    return proc;
+}
+static void purge_lottery(Scheduler *self, pcb_t *proc) {
+    lottery_data_t *lt = (lottery_data_t*) self->data;
+    for (int i = lt->size - 1; i >= 0; i--) {
+        if (lt->pool[i] != proc) continue;
+        lt->pool[i] = lt->pool[--lt->size];
+        lt->total_tickets -= proc->tickets;
+    }
+}
+
+Scheduler* create_lottery_scheduler() {
+    Scheduler *s = malloc(sizeof(Scheduler));
+    if (!s) return NULL;
+
+    lottery_data_t *lt = calloc(1, sizeof(lottery_data_t));
+    if (!lt) {
+        free(s);
+        return NULL;
+    }
+    lt->rng = lottery_seed ? lottery_seed : 1;
+    s->data = lt;
+
+    s->type = SCHEDULER_LOTTERY;
+    s->scheduler_enqueue = enqueue_lottery;
+    s->next = next_lottery;
+    s->preempt = preempt_lottery;
+    s->destroy = destroy_lottery;
+    s->scheduler_dequeue = dequeue_lottery;
+    s->queue = queue_lottery;
+    s->queue_size = queue_size_lottery;
+    s->queue_empty = queue_empty_lottery;
+    s->steal = steal_lottery;
+    s->next_timer = NULL;
+    s->purge = purge_lottery;
+
+    return s;
+}
+
+// --- Stride ---
+
+static long stride_of(const pcb_t *proc) {
+    return STRIDE_ONE / (proc->tickets > 0 ? proc->tickets : 1);
+}
+
+// kh->floor is the global pass: the lowest pass in play
+static long pass_key(keyed_heap_t *kh, pcb_t *proc) {
+    // New and woken processes join level with the rest instead of
+    // cashing in the time they were away
+    if (proc->pass < kh->floor) proc->pass = kh->floor;
+    return proc->pass;
+}
+
+static void charge_stride(keyed_heap_t *kh, pcb_t *proc) {
+    (void) kh;
+    proc->pass += stride_of(proc);
+}
+
+// Every tick goes back to the heap so the lowest pass runs next
+static int yields_stride(keyed_heap_t *kh, pcb_t *proc) {
+    (void) kh;
+    (void) proc;
+    return 1;
+}
+
+static void update_global_pass(keyed_heap_t *kh) {
+    if (kh->current && kh->current->pass > kh->floor) kh->floor = kh->current->pass;
+}
+
+static const keyed_heap_policy_t stride_policy = {
+    .name = "Stride",
+    .key = pass_key,
+    .charge = charge_stride,
+    .yields = yields_stride,
+    .settle = update_global_pass,
+};
+
+Scheduler* create_stride_scheduler() {
+    return create_keyed_heap_scheduler(SCHEDULER_STRIDE, &stride_policy);
+}
@@ -1,56 +1,98 @@
 // src/round_robin_scheduler.c
+#include <stdio.h>
 #include <stdlib.h>
 #include "../include/round_robin_scheduler.h"
-
-#define MAX_QUEUE 100
+#include "../include/run_queue.h"
+#include "../include/io.h"
 
 typedef struct {
-    pcb_t* queue[MAX_QUEUE];
-    int head, tail;
+    run_queue_t ready;
     int quantum;     // user-defined time slice
     int ticks_used;  // counts ticks by current process
     pcb_t* current;  // currently running process
+    int adaptive;    // retune the quantum (see round_robin_scheduler.h)
+    // Time slices since the last retune
+    int expired;     // used the whole quantum
+    int ended_early; // blocked or finished before it
+    int early_ticks; // ticks run by those
+    int queued_sum;  // ready queue length when each slice ended
+    int dispatches;  // context switches
+    int window_start; // sched_round the window began
 } rr_data_t;
 
+// A window of slices is complete: pick the quantum for the next one
+static void retune_quantum(rr_data_t *rr) {
+    int slices = rr->expired + rr->ended_early;
+    int rounds = sched_round - rr->window_start;
+    int quantum = rr->quantum;  // mixed: leave it, so it does not flap
+    if (4 * rr->expired >= 3 * slices) {
+        // CPU-bound: longer slices, fewer switches, unless they are rare already
+        if (rr->dispatches * RR_SWITCH_TICKS > rounds) quantum = rr->quantum * 2;
+    } else if (2 * rr->expired <= slices) {
+        // Interactive: just long enough for a typical burst
+        quantum = (rr->early_ticks + rr->ended_early - 1) / rr->ended_early;
+    }
+    // A longer queue means a longer wait for the process at its back
+    int queued = (rr->queued_sum + slices - 1) / slices;
+    if (queued > 0 && quantum * queued > RR_TARGET_RESPONSE) quantum = RR_TARGET_RESPONSE / queued;
+    if (quantum < RR_MIN_QUANTUM) quantum = RR_MIN_QUANTUM;
+    if (quantum > RR_MAX_QUANTUM) quantum = RR_MAX_QUANTUM;
+
+    if (quantum != rr->quantum) {
+        char buffer[192];
+        snprintf(buffer, sizeof(buffer),
+                "RR: quantum %d -> %d (%d of %d slices used it all, %d queued, %.2f switches per tick)\n",
+                rr->quantum, quantum, rr->expired, slices, queued,
+                rounds > 0 ? (double) rr->dispatches / rounds : 0.0);
+        log_trace(buffer);
+        rr->quantum = quantum;
+    }
+    rr->expired = rr->ended_early = rr->early_ticks = 0;
+    rr->queued_sum = rr->dispatches = 0;
+    rr->window_start = sched_round;
+}
+
+// The running process gave up the CPU; `full` if it used the whole quantum
+static void end_slice(rr_data_t *rr, int full) {
+    if (!rr->adaptive) return;
+    if (full) {
+        rr->expired++;
+    } else {
+        rr->ended_early++;
+        rr->early_ticks += rr->ticks_used + 1;  // the tick it blocked or finished in
+    }
+    rr->queued_sum += rq_size(&rr->ready);
+    if (rr->expired + rr->ended_early >= RR_TUNE_WINDOW) retune_quantum(rr);
+}
+
 static void enqueue_rr(Scheduler *self, pcb_t *proc) {
     rr_data_t *rr = (rr_data_t*) self->data;
-    rr->queue[rr->tail++] = proc;
+    if (rq_push(&rr->ready, proc) < 0) {
+        printf("Error: out of memory queueing process %d\n", proc->pid);
+        return;
+    }
     proc->state = READY;
-    proc->time_in_queue = 0; // Reset time in queue
-    update_pcb_in_memory(proc); // Update PCB in memory
+    pcb_enter_queue(proc); // Wait time counts from now
 }
 
 static pcb_t* next_rr(Scheduler *self) {
     rr_data_t *rr = (rr_data_t*) self->data;
 
+    // Waiting processes age by themselves (see pcb_wait_time)
     if(rr->current && rr->current->state != TERMINATED) {
-        // Increment time for all processes in the queue
-        for (int i = rr->head; i < rr->tail; i++) {
-            if (rr->queue[i] != rr->current) {
-                rr->queue[i]->time_in_queue++;
-                update_pcb_in_memory(rr->queue[i]); // Update PCB in memory
-            }
-        }
-        // Update the time for the current process
-        rr->current->time_in_queue = 0; // Reset time in queue for the running process
-        update_pcb_in_memory(rr->current); // Update PCB in memory
         // If current process is still running, return it
         return rr->current;
     }
-    if (rr->head < rr->tail) {
-        rr->current = rr->queue[rr->head++];
+    if (rr->current) end_slice(rr, 0);  // it finished
+    if (!rq_empty(&rr->ready)) {
+        rr->current = rq_pop(&rr->ready);
         rr->ticks_used = 0;
-        for (int i = rr->head; i < rr->tail; i++) {
-            if (rr->queue[i] != rr->current) {
-                rr->queue[i]->time_in_queue++;
-                update_pcb_in_memory(rr->queue[i]); // Update PCB in memory
-            }
-        }
-        rr->current->time_in_queue = 0; // Reset time in queue for the running process
-        update_pcb_in_memory(rr->current); // Update PCB in memory
+        rr->dispatches++;
+        pcb_leave_queue(rr->current); // Reset time in queue for the running process
         return rr->current;
     }
 
+    rr->current = NULL;  // it finished; its slot may be reused
     return NULL;  // no process to run
 }
 
@@ -64,6 +106,7 @@ static void preempt_rr(Scheduler *self, pcb_t *proc) {
         proc->state = READY;
         update_pcb_in_memory(proc); // Update PCB in memory
         enqueue_rr(self, proc);
+        end_slice(rr, 1);
         rr->current = NULL;
         rr->ticks_used = 0;
     } else {
@@ -75,6 +118,8 @@ static void preempt_rr(Scheduler *self, pcb_t *proc) {
 }
 
 static void destroy_rr(Scheduler *self) {
+    rr_data_t *rr = (rr_data_t*) self->data;
+    rq_free(&rr->ready);
     free(self->data);
     free(self);
 }
@@ -94,30 +139,49 @@ static void dequeue_rr(Scheduler* sched, pcb_t* proc) {
     // }
 
     // rr->tail = new_tail;
+    if (rr->current == proc) end_slice(rr, 0);  // blocked
     rr->current = NULL;
     //rr->ticks_used = 0;
 }
 static pcb_t* queue_rr(Scheduler *self) {
     rr_data_t *rr = (rr_data_t*) self->data;
-    if (rr->head < rr->tail)
-        return rr->queue[rr->head];
+    if (!rq_empty(&rr->ready))
+        return rq_at(&rr->ready, 0);
     return NULL;
 }
 static int queue_size_rr(Scheduler *self) {
     rr_data_t *rr = (rr_data_t*) self->data;
-    return rr->tail - rr->head;
+    return rq_size(&rr->ready);
 }
 static int queue_empty_rr(Scheduler *self) {
     rr_data_t *rr = (rr_data_t*) self->data;
-    return rr->head == rr->tail;
+    return rq_empty(&rr->ready);
+}
+static pcb_t* steal_rr(Scheduler *self) {
+    rr_data_t *rr = (rr_data_t*) self->data;
+    // The running process is kept aside in rr->current
+    return rq_pop_back(&rr->ready);
+}
+static void purge_rr(Scheduler *self, pcb_t *proc) {
+    rr_data_t *rr = (rr_data_t*) self->data;
+    rq_remove(&rr->ready, proc);
 }
 
 Scheduler* create_rr_scheduler(int quantum) {
     Scheduler *s = malloc(sizeof(Scheduler));
     rr_data_t *rr = calloc(1, sizeof(rr_data_t));
+    if (!s || !rr || rq_init(&rr->ready, 0) < 0) {
+        free(rr);
+        free(s);
+        return NULL;
+    }
 
     rr->quantum = quantum;
-    rr->head = rr->tail = 0;
+    if (quantum == RR_ADAPTIVE) {
+        rr->adaptive = 1;
+        rr->quantum = RR_ADAPTIVE_START;
+        rr->window_start = sched_round;
+    }
     s->type = SCHEDULER_RR;
     s->scheduler_enqueue = enqueue_rr;
     s->next    = next_rr;
@@ -127,6 +191,9 @@ Scheduler* create_rr_scheduler(int quantum) {
     s->queue     = queue_rr;
     s->queue_size = queue_size_rr;
     s->queue_empty = queue_empty_rr;
+    s->steal = steal_rr;
+    s->next_timer = NULL;
+    s->purge = purge_rr;
     s->data    = rr;
 
     return s;
@@ -0,0 +1,66 @@
+#include <stdlib.h>
+#include "../include/run_queue.h"
+
+int rq_init(run_queue_t *q, unsigned capacity) {
+    unsigned cap = 8;
+    while (cap < capacity) cap <<= 1;
+    q->slots = malloc(cap * sizeof(pcb_t*));
+    if (!q->slots) return -1;
+    q->mask = cap - 1;
+    q->head = q->tail = 0;
+    return 0;
+}
+
+void rq_free(run_queue_t *q) {
+    free(q->slots);
+    q->slots = NULL;
+}
+
+// Double the capacity, unwrapping the contents to start at slot 0
+static int rq_grow(run_queue_t *q) {
+    unsigned cap = q->mask + 1;
+    pcb_t **slots = malloc(2 * cap * sizeof(pcb_t*));
+    if (!slots) return -1;
+    for (unsigned i = 0; i < cap; i++) {
+        slots[i] = q->slots[(q->head + i) & q->mask];
+    }
+    free(q->slots);
+    q->slots = slots;
+    q->mask = 2 * cap - 1;
+    q->head = 0;
+    q->tail = cap;
+    return 0;
+}
+
+int rq_push(run_queue_t *q, pcb_t *proc) {
+    if (q->tail - q->head > q->mask && rq_grow(q) < 0) return -1;
+    q->slots[q->tail++ & q->mask] = proc;
+    return 0;
+}
+
+int rq_push_front(run_queue_t *q, pcb_t *proc) {
+    if (q->tail - q->head > q->mask && rq_grow(q) < 0) return -1;
+    q->slots[--q->head & q->mask] = proc;
+    return 0;
+}
+
+pcb_t* rq_pop(run_queue_t *q) {
+    if (rq_empty(q)) return NULL;
+    return q->slots[q->head++ & q->mask];
+}
+
+pcb_t* rq_pop_back(run_queue_t *q) {
+    if (rq_empty(q)) return NULL;
+    return q->slots[--q->tail & q->mask];
+}
+
+int rq_remove(run_queue_t *q, pcb_t *proc) {
+    unsigned kept = q->head;
+    for (unsigned i = q->head; i != q->tail; i++) {
+        pcb_t *p = q->slots[i & q->mask];
+        if (p != proc) q->slots[kept++ & q->mask] = p;
+    }
+    int removed = (int) (q->tail - kept);
+    q->tail = kept;
+    return removed;
+}
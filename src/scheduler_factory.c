@@ -0,0 +1,157 @@
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler_factory.h"
+#include "../include/fcfs_scheduler.h"
+#include "../include/round_robin_scheduler.h"
+#include "../include/mlfq_scheduler.h"
+#include "../include/sjf_scheduler.h"
+#include "../include/cfs_scheduler.h"
+#include "../include/deadline_scheduler.h"
+#include "../include/proportional_scheduler.h"
+
+typedef struct {
+    char *short_name;
+    char *name;
+    Scheduler* (*create)(void);
+    Scheduler* (*create_sliced)(int quantum);  // instead of create, takes the quantum
+} scheduler_kind_t;
+
+// Indexed by type; slot 0 is unused. The built-in schedulers are registered
+// first, in SCHEDULER_* order, so their types match the constants.
+static scheduler_kind_t *kinds = NULL;
+static int n_types = 0;
+static int cap_types = 0;
+
+static int add_kind(const char *short_name, const char *name,
+                    Scheduler* (*create)(void), Scheduler* (*create_sliced)(int)) {
+    if (n_types + 2 > cap_types) {
+        int cap = cap_types ? 2 * cap_types : 16;
+        scheduler_kind_t *grown = realloc(kinds, cap * sizeof(scheduler_kind_t));
+        if (!grown) return -1;
+        kinds = grown;
+        cap_types = cap;
+    }
+    scheduler_kind_t *k = &kinds[n_types + 1];
+    k->short_name = strdup(short_name);
+    k->name = strdup(name);
+    if (!k->short_name || !k->name) {
+        free(k->short_name);
+        free(k->name);
+        return -1;
+    }
+    k->create = create;
+    k->create_sliced = create_sliced;
+    return ++n_types;
+}
+
+static void register_builtins(void) {
+    if (n_types > 0) return;
+    add_kind("fcfs",    "FCFS",           create_fcfs_scheduler, NULL);
+    add_kind("rr",      "Round Robin",    NULL, create_rr_scheduler);
+    add_kind("mlfq",    "MLFQ",           create_mlfq_scheduler, NULL);
+    add_kind("sjf",     "SJF",            create_sjf_scheduler, NULL);
+    add_kind("srt",     "SRT",            create_srt_scheduler, NULL);
+    add_kind("cfs",     "CFS",            create_cfs_scheduler, NULL);
+    add_kind("edf",     "EDF",            create_edf_scheduler, NULL);
+    add_kind("rm",      "Rate Monotonic", create_rm_scheduler, NULL);
+    add_kind("lottery", "Lottery",        create_lottery_scheduler, NULL);
+    add_kind("stride",  "Stride",         create_stride_scheduler, NULL);
+}
+
+int scheduler_register(const char *short_name, const char *name, Scheduler* (*create)(void)) {
+    register_builtins();
+    if (!create || scheduler_type_by_name(short_name) > 0) return -1;
+    return add_kind(short_name, name, create, NULL);
+}
+
+int scheduler_load_module(const char *path) {
+    // .../libNAME.so or .../NAME_scheduler.so exports create_NAME_scheduler
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    if (strncmp(base, "lib", 3) == 0) base += 3;
+    char name[64];
+    snprintf(name, sizeof(name), "%.*s", (int) strcspn(base, "."), base);
+    size_t len = strlen(name);
+    if (len > 10 && strcmp(name + len - 10, "_scheduler") == 0) name[len - 10] = '\0';
+    if (name[0] == '\0') {
+        printf("Cannot tell the scheduler name from '%s'.\n", path);
+        return -1;
+    }
+
+    void *handle = dlopen(path, RTLD_NOW);
+    if (!handle) {
+        printf("Cannot load scheduler module: %s\n", dlerror());
+        return -1;
+    }
+    // Built against another struct Scheduler, it would leave hooks unset
+    const int *abi = dlsym(handle, "scheduler_abi_version");
+    if (!abi) {
+        printf("Scheduler module %s does not export scheduler_abi_version; rebuild it.\n", path);
+        dlclose(handle);
+        return -1;
+    }
+    if (*abi != SCHEDULER_ABI_VERSION) {
+        printf("Scheduler module %s was built for scheduler interface %d, not %d; rebuild it.\n",
+               path, *abi, SCHEDULER_ABI_VERSION);
+        dlclose(handle);
+        return -1;
+    }
+    char symbol[96];
+    snprintf(symbol, sizeof(symbol), "create_%s_scheduler", name);
+    Scheduler* (*create)(void);
+    *(void**) &create = dlsym(handle, symbol);
+    if (!create) {
+        printf("Scheduler module %s does not export %s.\n", path, symbol);
+        dlclose(handle);
+        return -1;
+    }
+
+    int type = scheduler_register(name, name, create);
+    if (type < 0) {
+        printf("Cannot register scheduler '%s' (name taken or out of memory).\n", name);
+        dlclose(handle);
+        return -1;
+    }
+    return type;  // the module stays loaded for the rest of the run
+}
+
+Scheduler* create_scheduler(int type, int quantum) {
+    register_builtins();
+    if (type < 1 || type > n_types) return NULL;
+    Scheduler *s = kinds[type].create_sliced ? kinds[type].create_sliced(quantum)
+                                             : kinds[type].create();
+    if (s) s->type = type;  // modules cannot know the type they were given
+    return s;
+}
+
+int scheduler_count(void) {
+    register_builtins();
+    return n_types;
+}
+
+int scheduler_takes_quantum(int type) {
+    register_builtins();
+    return type >= 1 && type <= n_types && kinds[type].create_sliced != NULL;
+}
+
+int scheduler_type_by_name(const char *name) {
+    register_builtins();
+    for (int type = 1; type <= n_types; type++) {
+        if (strcmp(kinds[type].short_name, name) == 0) return type;
+    }
+    return -1;
+}
+
+const char* scheduler_type_name(int type) {
+    register_builtins();
+    if (type < 1 || type > n_types) return "Unknown";
+    return kinds[type].name;
+}
+
+const char* scheduler_short_name(int type) {
+    register_builtins();
+    if (type < 1 || type > n_types) return "?";
+    return kinds[type].short_name;
+}
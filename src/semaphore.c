@@ -3,63 +3,136 @@
 #include "../include/priority_queue.h"
 #include "../include/semaphore.h"
 #include "../include/os.h"
-#include "../include/gui.h"
+#include "../include/io.h"
 //#include "../include/scheduler_interface.h"
 //#include "../include/priority_queue.h"
 
-// External declaration of resource_panel
-extern GtkWidget *resource_panel;
+// Semaphores by ID, in the order their names were first seen
+static semaphore_t *semaphores = NULL;
+static int sem_count = 0;
+static int sem_cap = 0;
 
-#define MAX_SEMAPHORES 3
+// Name -> ID + 1 (0 = empty slot), open addressing with linear probing.
+// Capacity is a power of two kept at least twice the number of names.
+static int *sem_index = NULL;
+static int index_cap = 0;
 
-static semaphore_t semaphores[MAX_SEMAPHORES];
-static int sem_count = 0;
+static unsigned name_hash(const char *name) {
+    unsigned h = 2166136261u;  // FNV-1a
+    for (; *name; name++) h = (h ^ (unsigned char) *name) * 16777619u;
+    return h;
+}
 
-void sem_init_all() {
-    sem_count = 0;
-    
-    // Clear all semaphores first
-    memset(semaphores, 0, sizeof(semaphores));
-    
-    // Resource names in fixed order
-    const char *resource_names[] = {
-        RESOURCE_USER_INPUT,
-        RESOURCE_USER_OUTPUT,
-        RESOURCE_FILE
-    };
-    
-    // Initialize all three semaphores
-    for (int i = 0; i < 3; i++) {
-        // Initialize semaphore
-        strcpy(semaphores[i].name, resource_names[i]);
-        semaphores[i].value = 1;  // Start as free
-        semaphores[i].initialized = 1;
-        semaphores[i].queue = NULL;
-        semaphores[i].queue_size = 0;
-        semaphores[i].current_holder = -1;
-        sem_count++;
+// Slot of `name` in sem_index, or the empty slot where it would go
+static int index_slot(const char *name) {
+    unsigned mask = index_cap - 1;
+    unsigned i = name_hash(name) & mask;
+    while (sem_index[i] && strcmp(semaphores[sem_index[i] - 1].name, name) != 0) i = (i + 1) & mask;
+    return i;
+}
+
+// Room for one more semaphore; -1 if out of memory
+static int sem_reserve(void) {
+    if (sem_count == sem_cap) {
+        int cap = sem_cap ? 2 * sem_cap : 16;
+        semaphore_t *grown = realloc(semaphores, cap * sizeof(semaphore_t));
+        if (!grown) return -1;
+        semaphores = grown;
+        sem_cap = cap;
+    }
+    if (2 * (sem_count + 1) > index_cap) {
+        int cap = index_cap ? 2 * index_cap : 32;
+        int *index = calloc(cap, sizeof(int));
+        if (!index) return -1;
+        free(sem_index);
+        sem_index = index;
+        index_cap = cap;
+        for (int id = 0; id < sem_count; id++) sem_index[index_slot(semaphores[id].name)] = id + 1;
     }
+    return 0;
 }
 
-semaphore_t* get_semaphore(char *name) {
-    for (int i = 0; i < sem_count; i++) {
-        if (strcmp(semaphores[i].name, name) == 0)
-            return &semaphores[i];
+static void sem_reset(semaphore_t *sem) {
+    while (sem->queue) dequeue(&sem->queue);
+    sem->value = sem->count;
+    sem->initialized = 1;
+    sem->queue_size = 0;
+    sem->current_holder = -1;
+}
+
+// ID of `name`, registering it (free, with a count of 1) if new
+static int sem_intern(const char *name) {
+    if (index_cap > 0) {
+        int id = sem_index[index_slot(name)] - 1;
+        if (id >= 0) return id;
     }
-    if (sem_count < MAX_SEMAPHORES) {
-        strcpy(semaphores[sem_count].name, name);
-        semaphores[sem_count].value = 1;
-        semaphores[sem_count].queue_size = 0;
-        semaphores[sem_count].initialized = 1;
-        semaphores[sem_count].current_holder = -1;
-        semaphores[sem_count].queue = NULL;
-        return &semaphores[sem_count++];
+    if (sem_reserve() < 0) return -1;
+    semaphore_t *sem = &semaphores[sem_count];
+    memset(sem, 0, sizeof(semaphore_t));
+    sem->name = strdup(name);
+    if (!sem->name) return -1;
+    sem->count = 1;
+    sem_reset(sem);
+    sem_index[index_slot(name)] = sem_count + 1;
+    return sem_count++;
+}
+
+// The standard resources come first, so their IDs are the RESOURCE_*_ID values
+static void sem_register_standard(void) {
+    if (sem_count > 0) return;
+    sem_intern(RESOURCE_USER_INPUT);
+    sem_intern(RESOURCE_USER_OUTPUT);
+    sem_intern(RESOURCE_FILE);
+}
+
+void sem_init_all() {
+    sem_register_standard();
+
+    // Reset every known semaphore. Names (and so IDs) survive a reset because
+    // compiled programs refer to resources by ID.
+    for (int i = 0; i < sem_count; i++) sem_reset(&semaphores[i]);
+}
+
+int sem_lookup(char *name) {
+    sem_register_standard();
+    return sem_intern(name);
+}
+
+int sem_set_count(const char *name, int count) {
+    if (count < 1) return -1;
+    sem_register_standard();
+    int id = sem_intern(name);
+    if (id < 0) return -1;
+    semaphore_t *sem = &semaphores[id];
+    if (sem->value == sem->count && sem->queue_size == 0) sem->value = count;  // not in use
+    sem->count = count;
+    return id;
+}
+
+int sem_load_config(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        printf("Cannot open resource config %s\n", path);
+        return -1;
     }
-    return NULL; // Error: too many semaphores
+    // One "name count" per line; blank lines and # comments are skipped
+    char line[256], name[128];
+    int count, line_no = 0, status = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+        char *p = line + strspn(line, " \t");
+        if (*p == '#' || *p == '\n' || *p == '\0') continue;
+        if (sscanf(p, "%127s %d", name, &count) != 2 || sem_set_count(name, count) < 0) {
+            printf("%s:%d: expected \"name count\" with a count of at least 1\n", path, line_no);
+            status = -1;
+        }
+    }
+    fclose(f);
+    return status;
 }
 
-void sem_wait(char *name, pcb_t* pcb, Scheduler* scheduler) {
-    semaphore_t *sem = get_semaphore(name);
+void sem_wait_id(int id, pcb_t* pcb, Scheduler* scheduler) {
+    semaphore_t *sem = &semaphores[id];
     if (sem->value > 0) {
         sem->value--;
         sem->current_holder = pcb->pid;
@@ -73,13 +146,11 @@ void sem_wait(char *name, pcb_t* pcb, Scheduler* scheduler) {
     }
     
     // Update the GUI to reflect the new resource state
-    if (resource_panel) {
-        update_resource_panel(resource_panel);
-    }
+    notify_resources_changed();
 }
 
-void sem_signal(char *name, Scheduler* scheduler) {
-    semaphore_t *sem = get_semaphore(name);
+void sem_signal_id(int id, Scheduler* scheduler) {
+    semaphore_t *sem = &semaphores[id];
     if (sem->queue_size > 0) {
         pcb_t* pcb = dequeue(&(sem->queue));
         sem->queue_size--;
@@ -90,69 +161,74 @@ void sem_signal(char *name, Scheduler* scheduler) {
         sem->current_holder = pcb->pid;
     } else {
         sem->value++;
-        sem->current_holder = -1;
+        // The last acquirer is shown until every unit is back
+        if (sem->value >= sem->count) sem->current_holder = -1;
     }
     
     // Update the GUI to reflect the new resource state
-    if (resource_panel) {
-        update_resource_panel(resource_panel);
+    notify_resources_changed();
+}
+
+void sem_forget_holder(int pid) {
+    for (int i = 0; i < sem_count; i++) {
+        if (semaphores[i].current_holder == pid) semaphores[i].current_holder = -1;
     }
 }
 
-void get_resource_status(resource_status_t* status_array, int* num_resources) {
-    // Always return exactly 3 resources in fixed order
-    *num_resources = 3;
-    
-    // Define our three resources in fixed order
-    struct {
-        const char* name;
-        int index;  // -1 means not found
-    } resources[] = {
-        {RESOURCE_USER_INPUT, -1},
-        {RESOURCE_USER_OUTPUT, -1},
-        {RESOURCE_FILE, -1}
-    };
-    
-    // First, find each resource in the semaphores array
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < sem_count; j++) {
-            if (strcmp(semaphores[j].name, resources[i].name) == 0) {
-                resources[i].index = j;
-                break;
-            }
-        }
+void sem_wait(char *name, pcb_t* pcb, Scheduler* scheduler) {
+    int id = sem_lookup(name);
+    if (id < 0) {
+        printf("Error: out of memory registering semaphore '%s'\n", name);
+        return;
     }
-    
-    // Then, populate the status array in the fixed order
-    for (int i = 0; i < 3; i++) {
-        // Copy the resource name
-        strcpy(status_array[i].name, resources[i].name);
-        
-        if (resources[i].index != -1) {
-            // Resource was found in semaphores array
-            semaphore_t* sem = &semaphores[resources[i].index];
-            status_array[i].value = sem->value;
-            status_array[i].current_holder = sem->current_holder;
-            status_array[i].queue_size = sem->queue_size;
-            
-            // Copy waiting PIDs
-            if (sem->queue_size > 0) {
-                status_array[i].waiting_pids = malloc(sem->queue_size * sizeof(int));
-                Node* current = sem->queue;
-                int j = 0;
-                while (current && j < sem->queue_size) {
-                    status_array[i].waiting_pids[j++] = current->pcb->pid;
-                    current = current->next;
-                }
-            } else {
-                status_array[i].waiting_pids = NULL;
+    sem_wait_id(id, pcb, scheduler);
+}
+
+void sem_signal(char *name, Scheduler* scheduler) {
+    int id = sem_lookup(name);
+    if (id < 0) {
+        printf("Error: out of memory registering semaphore '%s'\n", name);
+        return;
+    }
+    sem_signal_id(id, scheduler);
+}
+
+resource_status_t* get_resource_status(int* num_resources) {
+    sem_register_standard();
+    *num_resources = 0;
+    resource_status_t* status_array = calloc(sem_count, sizeof(resource_status_t));
+    if (!status_array) return NULL;
+
+    // Every resource, in ID order (the standard three first)
+    for (int i = 0; i < sem_count; i++) {
+        semaphore_t* sem = &semaphores[i];
+        status_array[i].name = sem->name;
+        status_array[i].value = sem->value;
+        status_array[i].count = sem->count;
+        status_array[i].current_holder = sem->current_holder;
+        status_array[i].queue_size = sem->queue_size;
+
+        // Copy waiting PIDs
+        if (sem->queue_size > 0) {
+            status_array[i].waiting_pids = malloc(sem->queue_size * sizeof(int));
+            if (!status_array[i].waiting_pids) {
+                status_array[i].queue_size = 0;
+                continue;
+            }
+            Node* current = sem->queue;
+            int j = 0;
+            while (current && j < sem->queue_size) {
+                status_array[i].waiting_pids[j++] = current->pcb->pid;
+                current = current->next;
             }
-        } else {
-            // Resource not found, set default values
-            status_array[i].value = 1;  // Free
-            status_array[i].current_holder = -1;  // No holder
-            status_array[i].queue_size = 0;
-            status_array[i].waiting_pids = NULL;
         }
     }
+    *num_resources = sem_count;
+    return status_array;
+}
+
+void free_resource_status(resource_status_t* status_array, int num_resources) {
+    if (!status_array) return;
+    for (int i = 0; i < num_resources; i++) free(status_array[i].waiting_pids);
+    free(status_array);
 }
@@ -0,0 +1,864 @@
+#include "../include/os.h"
+#include "../include/memory.h"
+#include "../include/parser.h"
+#include "../include/compiler.h"
+#include "../include/program_cache.h"
+#include "../include/text_segment.h"
+#include "../include/semaphore.h"
+#include "../include/scheduler_interface.h"
+#include "../include/mlfq_scheduler.h"
+#include "../include/proportional_scheduler.h"
+#include "../include/cfs_scheduler.h"
+#include "../include/scheduler_factory.h"
+#include "../include/pcb_heap.h"
+#include "../include/proc_table.h"
+#include "../include/io.h"
+#include "../include/simulation.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <string.h>
+
+// Global Variables
+Scheduler* scheduler = NULL;
+int clock_tick = 0;
+int simulation_running = 1; // 0 = stopped, 1 = running
+int deadline_misses = 0;
+int deadline_miss_ticks = 0;
+int lateness_hist[LATENESS_BUCKETS];
+int finished_processes = 0;
+int finished_with_deadline = 0;
+long total_turnaround = 0;
+cpu_t cpus[MAX_CPUS];
+int num_cpus = 1;
+int balance_scans = 0;
+int event_driven = 0;
+int tick_limit = INT_MAX;
+int auto_mode = 0;           // 0 = step-by-step, 1 = auto-run
+pcb_t** ready_queue = NULL;    // filled by get_ready_queue, NULL-terminated
+pcb_t** blocked_queue = NULL;  // filled by get_blocked_queue, NULL-terminated
+pcb_t* running_process = NULL;
+pcb_t* current = NULL; // Current process being executed
+
+// Processes that have not arrived yet, keyed on arrival time
+static pcb_heap_t arrivals;
+
+// Admitted processes whose deadline has not passed yet, keyed on deadline.
+// Processes that finish in time are dropped once their deadline comes up.
+static pcb_heap_t deadlines;
+static int overdue = 0;  // processes past their deadline and not finished
+
+// Function Prototypes
+//void load_programs();
+void choose_scheduler();
+void simulation_step();
+void add_process();
+void load_program();
+static cpu_t* least_loaded_cpu();
+//void update_gui();
+int extractFirstInt(const char *str) {
+    int num = 0;
+    int found = 0;
+
+    // Traverse the string
+    while (*str) {
+        if  (isdigit(*str)) {
+            num = num * 10 + (*str - '0');
+            found = 1;
+        } else if (found) {
+            // If an integer was found and we hit a non-digit, break
+            break;
+        }
+        str++;
+    }
+
+    // If no number was found, you can decide what to return (e.g., 0 or an error code)
+    return found ? num : -1; // Returns -1 if no integer was found
+}
+// Collect the processes in `state` from the process table into *list,
+// NULL-terminated and sized to fit
+static void collect_state(pcb_t*** list, proc_state_t state) {
+    pcb_t** grown = realloc(*list, (proc_count() + 1) * sizeof(pcb_t*));
+    if (!grown) {
+        printf("Error: out of memory listing processes.\n");
+        return;
+    }
+    *list = grown;
+    int j = 0;
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+        if (p->state == state) grown[j++] = p;
+    }
+    grown[j] = NULL;
+}
+
+void get_ready_queue () {
+    // Processes waiting to run, on any CPU
+    collect_state(&ready_queue, READY);
+}
+
+void get_blocked_queue () {
+    // Processes waiting on a resource
+    collect_state(&blocked_queue, BLOCKED);
+}
+
+void get_running_process () {
+    // This function should return the running process from the scheduler
+    if(!current || current->state != RUNNING){
+        printf("Error: No running process.\n");
+        return;
+    }
+    else{
+        running_process = current;
+    }
+}
+
+
+void add_process() {
+    
+    char filename[MAX_LINE_LEN];
+    int arrival_time;
+    // Read from temporary file
+    FILE* temp_file = fopen("temp_input.txt", "r");
+    if (!temp_file) {
+        printf("Error: Could not read input file.\n");
+        return;
+    }
+
+    if (fscanf(temp_file, "%s\n%d", filename, &arrival_time) != 2) {
+        printf("Error: Invalid input format.\n");
+        fclose(temp_file);
+        return;
+    }
+    printf("Adding process from %s at time %d\n", filename, arrival_time);
+    // Optional deadline, period, tickets and nice
+    proc_params_t params = { 0, 0, 0, 0 };
+    if (fscanf(temp_file, "%d %d %d %d", &params.deadline, &params.period, &params.tickets,
+               &params.nice) < 1) {
+        params.deadline = 0;
+    }
+    fclose(temp_file);
+
+    sim_add_process(filename, arrival_time, &params);
+}
+
+// Free the memory and process table slots of processes that terminated
+// before the last tick. Their statistics were recorded and their queue
+// entries purged when they finished, and every scheduler has picked
+// something else since. Returns how many were reaped.
+static int reap_terminated() {
+    // A scheduler that cannot purge may still hold finished processes
+    for (int i = 0; i < num_cpus; i++) {
+        if (cpus[i].sched && !cpus[i].sched->purge) return 0;
+    }
+    int reaped = 0;
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+        if (p->state != TERMINATED || p->finish_tick >= clock_tick - 1 || p->dirty) continue;
+        // Still in the deadline heap
+        if (p->deadline >= clock_tick && !p->deadline_missed) continue;
+        mem_free(p->mem_low, p->mem_high - p->mem_low + 1);
+        text_segment_detach(p->prog);
+        sem_forget_holder(p->pid);
+        proc_release(p);
+        reaped++;
+    }
+    return reaped;
+}
+
+int sim_add_process(const char *filename, int arrival_time, const proc_params_t *params) {
+    // Code is shared by every process running the same program; it is
+    // loaded into memory (and compiled) only by the first of them
+    text_segment_t text;
+    int attached = text_segment_attach(filename, &text);
+    if (attached == -2 && reap_terminated() > 0) {
+        attached = text_segment_attach(filename, &text);  // finished processes made room
+    }
+    if (attached == -2) {
+        printf("Error: out of memory loading the code of %s\n", filename);
+        return -1;
+    }
+    if (attached < 0) {
+        printf("Failed to open %s\n", filename);
+        return -1;
+    }
+
+    // --- Refined Memory Allocation ---
+    // 1. Calculate total size needed: variables and PCB, the code lives in its own segment
+    int num_vars = 3;
+    int pcb_fields_count = 9; // pid, state, prio, pc, low, high, pcb_idx, time_in_queue, arrival_time
+    int total_size = num_vars + pcb_fields_count;
+
+    int mem_start_index = mem_alloc(total_size);
+    if (mem_start_index < 0 && reap_terminated() > 0) {
+        mem_start_index = mem_alloc(total_size);  // finished processes made room
+    }
+    if (mem_start_index < 0) {
+        printf("Memory allocation failed for process (need %d words)\n", total_size);
+        text_segment_detach(text.prog);
+        return -1;
+    }
+
+    // 2. Define memory regions
+    int var_start = mem_start_index;
+    int pcb_start = var_start + num_vars;
+
+    // 3. Setup PCB structure
+    pcb_t *p = proc_alloc();
+    if (!p) {
+        printf("Error: out of memory adding %s to the process table\n", filename);
+        mem_free(mem_start_index, total_size);
+        text_segment_detach(text.prog);
+        return -1;
+    }
+    // The number in the file name is the PID unless another process has it
+    if (proc_assign_pid(p, extractFirstInt(filename)) < 0) {
+        printf("Error: no PID left for %s\n", filename);
+        proc_release(p);
+        mem_free(mem_start_index, total_size);
+        text_segment_detach(text.prog);
+        return -1;
+    }
+    p->state = NEW;
+    p->priority = 0;
+    p->pc = text.base;
+    p->mem_low = var_start;
+    p->mem_high = var_start + total_size - 1;
+    p->pcb_index = pcb_start;
+    p->time_in_queue = 0;
+    p->enqueue_tick = -1;
+    p->vruntime = 0;
+    p->nice = params && params->nice > 0 ? params->nice : 0;
+    if (p->nice > CFS_MAX_NICE) p->nice = CFS_MAX_NICE;
+    p->finish_tick = -1;
+    // A periodic process without an explicit deadline is due at the end of its period
+    int relative_deadline = 0;
+    p->period = 0;
+    if (params) {
+        relative_deadline = params->deadline > 0 ? params->deadline : params->period;
+        p->period = params->period > 0 ? params->period : 0;
+    }
+    p->deadline = relative_deadline > 0 ? arrival_time + relative_deadline : -1;
+    p->deadline_missed = 0;
+    p->tickets = params && params->tickets > 0 ? params->tickets : DEFAULT_TICKETS;
+    p->pass = 0;
+    p->cpu_ticks = 0;
+    p->prog = text.prog;
+    p->code_base = text.base;
+    p->code_len = text.prog->n_code;
+    p->arrival_time = arrival_time;
+
+    // Wait in the arrival queue until load_program admits it
+    if ((!arrivals.items && ph_init(&arrivals, 0) < 0) ||
+        ph_push(&arrivals, arrival_time, p) < 0) {
+        printf("Error: out of memory queueing the arrival of %s\n", filename);
+        proc_release(p);
+        mem_free(mem_start_index, total_size);
+        text_segment_detach(text.prog);
+        return -1;
+    }
+
+    // 4. Write PCB and arrival time to memory
+    int current_idx = pcb_start;
+    mem_write_int(current_idx++, "pid", p->pid);
+    mem_write_enum(current_idx++, "state", p->state, proc_state_names);
+    mem_write_int(current_idx++, "priority", p->priority);
+    mem_write_int(current_idx++, "pc", p->pc);
+    mem_write_int(current_idx++, "mem_low", p->mem_low);
+    mem_write_int(current_idx++, "mem_high", p->mem_high);
+    mem_write_int(current_idx++, "pcb_index", p->pcb_index);
+    mem_write_int(current_idx++, "time_in_queue", p->time_in_queue);
+    mem_write_int(current_idx++, "arrival_time", arrival_time);
+
+    printf("Process added successfully.\n");
+    return 0;
+}
+
+void choose_scheduler() {
+    //should be from gui
+    
+    printf("Choose scheduler:\n");
+    for (int type = 1; type <= scheduler_count(); type++) {
+        printf("%d. %s\n", type, scheduler_type_name(type));
+    }
+    printf("Choice: ");
+    int choice, quantum = 0;
+    scanf("%d", &choice);
+    while (getchar() != '\n'); // Consume trailing newline
+
+    if (choice < 1 || choice > scheduler_count()) {
+        printf("Invalid choice.\n");
+        exit(1);
+    }
+    if (scheduler_takes_quantum(choice)) {
+        printf("Enter quantum (0 = adaptive): ");
+        scanf("%d", &quantum);
+        while (getchar() != '\n'); // Consume trailing newline
+    }
+    
+    if (sim_set_scheduler(choice, quantum) < 0) {
+        printf("Failed to create scheduler. Out of memory.\n");
+        exit(1);
+    }
+}
+
+int sim_set_cpus(int n) {
+    if (n < 1 || n > MAX_CPUS) return -1;
+    num_cpus = n;
+    return 0;
+}
+
+int sim_set_scheduler(int type, int quantum) {
+    sim_destroy_scheduler();
+    for (int i = 0; i < num_cpus; i++) {
+        memset(&cpus[i], 0, sizeof(cpu_t));
+        cpus[i].id = i;
+        cpus[i].sched = create_scheduler(type, quantum);
+        if (!cpus[i].sched) {
+            sim_destroy_scheduler();
+            return -1;
+        }
+    }
+    balance_scans = 0;
+    scheduler = cpus[0].sched;
+    return 0;
+}
+
+void sim_destroy_scheduler() {
+    for (int i = 0; i < MAX_CPUS; i++) {
+        if (cpus[i].sched) cpus[i].sched->destroy(cpus[i].sched);
+        cpus[i].sched = NULL;
+        cpus[i].current = NULL;
+    }
+    scheduler = NULL;
+}
+
+void sim_reset_processes() {
+    ph_free(&arrivals);
+    ph_free(&deadlines);
+    overdue = 0;
+    proc_table_reset();
+    finished_processes = 0;
+    finished_with_deadline = 0;
+    total_turnaround = 0;
+    deadline_misses = 0;
+    deadline_miss_ticks = 0;
+    memset(lateness_hist, 0, sizeof(lateness_hist));
+}
+
+void load_program() {
+    // Only the processes whose time has come are looked at
+    while (!ph_empty(&arrivals) && ph_top_key(&arrivals) <= clock_tick) {
+        pcb_t *proc = ph_pop(&arrivals);
+        proc->state = READY;
+        if (proc->deadline >= 0 &&
+            ((!deadlines.items && ph_init(&deadlines, 0) < 0) ||
+             ph_push(&deadlines, proc->deadline, proc) < 0)) {
+            printf("Error: out of memory tracking the deadline of process %d\n", proc->pid);
+        }
+        Scheduler *target = least_loaded_cpu()->sched;
+        target->scheduler_enqueue(target, proc);
+        char buffer[256];
+        snprintf(buffer, sizeof(buffer), "Process %d arrived at time %d\n", proc->pid, clock_tick);
+        log_trace(buffer);
+    }
+}
+// void load_programs() {
+//     const char* filenames[] = {
+//         "programs/Program_1.txt",
+//         "programs/Program_2.txt",
+//         "programs/Program_3.txt"
+//     };
+
+//     num_processes = 3;
+
+//     for (int i = 0; i < num_processes; i++) {
+//         FILE* f = fopen(filenames[i], "r");
+//         if (!f) {
+//             printf("Failed to open %s\n", filenames[i]);
+//             exit(1);
+//         }
+
+//         // Estimate number of instructions first
+//         int code_start = mem_alloc(20); // allocate big enough block: code + 3 vars
+//         if (code_start < 0) {
+//             printf("Memory allocation failed for process %d\n", i + 1);
+//             exit(1);
+//         }
+
+//         int var_start = code_start;         // variables will be at the start
+//         int code_mem_start = code_start + 3; // instructions start after vars
+
+//         int current_idx = code_mem_start;
+//         char line[MAX_LINE_LEN];
+
+//         int instruction_count = 0;
+//         while (fgets(line, sizeof(line), f)) {
+//             if (current_idx >= MAX_MEM_WORDS) {
+//                 printf("Memory overflow loading %s\n", filenames[i]);
+//                 exit(1);
+//             }
+
+//             // Save each instruction as text inside memory
+//             mem_write(current_idx, "instruction", line); 
+//             current_idx++;
+//             instruction_count++;
+//         }
+
+//         // Setup PCB
+//         processes[i].pid = i + 1;
+//         processes[i].state = READY;
+//         processes[i].priority = 0; // MLFQ start at top level
+//         processes[i].pc = code_mem_start;
+//         processes[i].mem_low = var_start;
+//         processes[i].pcb_index = current_idx; // where the PCB starts in memory
+
+        
+
+//         scheduler->scheduler_enqueue(scheduler, &processes[i]);
+//         fclose(f);
+//     }
+// }
+// Mark `proc` terminated this tick and record its turnaround and lateness,
+// which outlive its process table slot
+static void finish_process(pcb_t *proc) {
+    proc->state = TERMINATED;
+    proc->finish_tick = clock_tick;
+    // A process whose writeFile/readFile woke itself up was queued twice;
+    // the entry left behind must not bring it back
+    for (int i = 0; i < num_cpus; i++) {
+        if (cpus[i].sched && cpus[i].sched->purge) cpus[i].sched->purge(cpus[i].sched, proc);
+    }
+    finished_processes++;
+    total_turnaround += proc->finish_tick + 1 - proc->arrival_time;
+    if (proc->deadline < 0) return;
+    if (proc->deadline_missed) overdue--;
+
+    finished_with_deadline++;
+    int lateness = proc->finish_tick + 1 - proc->deadline;
+    int bucket = 0;
+    while (lateness > 0 && bucket < LATENESS_BUCKETS - 1) {
+        bucket++;
+        lateness >>= 1;
+    }
+    lateness_hist[bucket]++;
+}
+
+// Turnaround (arrival to completion) of every process still in the table,
+// and the mean over all that finished, to compare schedulers on the same
+// workload
+static void report_turnaround() {
+    char buffer[256];
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+        if (p->finish_tick < 0) continue;
+        int turnaround = p->finish_tick + 1 - p->arrival_time;
+        snprintf(buffer, sizeof(buffer), "Process %d: arrived %d, finished %d, turnaround %d\n",
+                p->pid, p->arrival_time, p->finish_tick, turnaround);
+        log_message(buffer);
+    }
+    if (finished_processes > 0) {
+        snprintf(buffer, sizeof(buffer), "Mean turnaround: %.2f ticks\n",
+                (double) total_turnaround / finished_processes);
+        log_message(buffer);
+    }
+}
+
+// Drop processes from the top of the deadline heap that finished in time
+static void drop_finished_deadlines() {
+    while (!ph_empty(&deadlines) && ph_top(&deadlines)->state == TERMINATED) {
+        ph_pop(&deadlines);
+    }
+}
+
+// Count the processes that are past their deadline at the start of this
+// tick; only the deadlines that have just passed are looked at
+static void check_deadlines() {
+    while (!ph_empty(&deadlines) && ph_top_key(&deadlines) <= clock_tick) {
+        pcb_t *p = ph_pop(&deadlines);
+        if (p->state == TERMINATED) continue;
+        p->deadline_missed = 1;
+        deadline_misses++;
+        overdue++;
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "Process %d missed its deadline (tick %d)\n", p->pid, p->deadline);
+        log_message(buffer);
+    }
+    deadline_miss_ticks += overdue;
+}
+
+// Finished processes with a deadline, by how late they were
+static void report_deadlines() {
+    static const char *const bucket_names[LATENESS_BUCKETS] = {
+        "on time", "1", "2-3", "4-7", "8-15", "16-31", "32-63", "64+"
+    };
+    char buffer[256];
+    if (finished_with_deadline == 0) return;
+
+    snprintf(buffer, sizeof(buffer), "Deadlines: %d of %d missed, %d ticks past deadline\n",
+            deadline_misses, finished_with_deadline, deadline_miss_ticks);
+    log_message(buffer);
+    for (int b = 0; b < LATENESS_BUCKETS; b++) {
+        if (lateness_hist[b] == 0) continue;
+        snprintf(buffer, sizeof(buffer), "  lateness %s%s: %d\n", bucket_names[b],
+                b == 0 ? "" : " ticks", lateness_hist[b]);
+        log_message(buffer);
+    }
+}
+
+void sim_report_shares() {
+    char buffer[256];
+    // CFS shares by weight, the others by tickets
+    int by_weight = scheduler && scheduler->type == SCHEDULER_CFS;
+    long total_cpu = 0, total_shares = 0;
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+        total_cpu += p->cpu_ticks;
+        total_shares += by_weight ? cfs_weight(p->nice) : p->tickets;
+    }
+    if (total_cpu == 0 || total_shares == 0) return;
+
+    for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+        if (by_weight) {
+            snprintf(buffer, sizeof(buffer), "Process %d: %d ticks on CPU (%.1f%%), nice %d (%.1f%%)\n",
+                    p->pid, p->cpu_ticks, 100.0 * p->cpu_ticks / total_cpu,
+                    p->nice, 100.0 * cfs_weight(p->nice) / total_shares);
+        } else {
+            snprintf(buffer, sizeof(buffer), "Process %d: %d ticks on CPU (%.1f%%), %d tickets (%.1f%%)\n",
+                    p->pid, p->cpu_ticks, 100.0 * p->cpu_ticks / total_cpu,
+                    p->tickets, 100.0 * p->tickets / total_shares);
+        }
+        log_message(buffer);
+    }
+}
+
+// Run one instruction of the process `cpu` picked this tick
+static void run_on_cpu(cpu_t *cpu) {
+    char buffer[256];
+    current = cpu->current;
+    cpu->busy_ticks++;
+    if (num_cpus > 1) {
+        snprintf(buffer, sizeof(buffer), "[CPU %d]\n", cpu->id);
+        log_trace(buffer);
+    }
+
+    // Check if the process selected by the scheduler is actually ready/running
+    if (current->state == BLOCKED || current->state == TERMINATED) {
+        snprintf(buffer, sizeof(buffer), "Scheduler returned non-runnable process %d (%s). Skipping tick.\n", 
+                current->pid, state_type_to_string(current->state));
+        log_trace(buffer);
+        return;
+    }
+
+    current->state = RUNNING;
+    update_pcb_in_memory(current); // Update PCB in memory
+
+    // --- Add PC Validity Check ---
+    // Code boundaries of the process's code segment
+    int code_start_index = current->code_base;
+    int code_end_index = current->code_base + current->code_len;
+    if (current->pc < code_start_index || current->pc >= code_end_index) {
+        snprintf(buffer, sizeof(buffer), "Error: PC (%d) is outside valid code range [%d, %d) for PID %d. Terminating process.\n", 
+                current->pc, code_start_index, code_end_index, current->pid);
+        log_message(buffer);
+        finish_process(current);
+        update_pcb_in_memory(current); // Update state in memory
+        return;
+    }
+    
+    snprintf(buffer, sizeof(buffer), "Running process %d (Priority: %d, PC: %d, State: %s)\n", 
+            current->pid, current->priority, current->pc, state_type_to_string(current->state));
+    log_trace(buffer);
+    
+    // Fetch one instruction: the text is kept for display, the bytecode
+    // was compiled when the program was loaded
+    char* instruction_string = memory_pool[current->pc].value;
+    const program_t* prog = current->prog;
+    const bc_insn_t* insn = &prog->code[current->pc - code_start_index];
+    
+    snprintf(buffer, sizeof(buffer), "  Fetching instruction at mem[%d]: %s", current->pc, instruction_string);
+    log_trace(buffer);
+
+    if (insn->op == OP_INVALID) {
+        snprintf(buffer, sizeof(buffer), "Error: Failed to parse instruction for PID %d at PC %d: '%s'. Terminating process.\n", 
+                current->pid, current->pc, instruction_string);
+        log_message(buffer);
+        finish_process(current);
+        update_pcb_in_memory(current);
+        return;
+    }
+    // Dispatch on the opcode; operands are already slots and resource IDs
+    switch (insn->op) {
+        case OP_ASSIGN_INPUT:
+        case OP_ASSIGN_READ_FILE:
+        case OP_ASSIGN: exec_assign(current, prog, insn); break;
+        case OP_PRINT: exec_print(current, prog, insn); break;
+        case OP_PRINT_FROM_TO: exec_print_from_to(current, prog, insn); break;
+        case OP_WRITE_FILE: exec_write_file(current, prog, insn); break;
+        case OP_READ_FILE: exec_read_file(current, prog, insn); break;
+        case OP_SEM_WAIT:
+        case OP_SEM_SIGNAL: exec_semaphore(current, prog, insn); break;
+    }
+
+    current->pc++;
+    current->cpu_ticks++;
+    update_pcb_in_memory(current); // Update PCB in memory
+
+    // Check if process finished
+    if (current->state == BLOCKED) {
+        snprintf(buffer, sizeof(buffer), "Process %d is now BLOCKED.\n", current->pid);
+        log_trace(buffer);
+        return;
+    }
+    
+    // Check for process termination
+    if (current->pc >= code_end_index) {
+        finish_process(current);
+        snprintf(buffer, sizeof(buffer), "Process %d finished execution (PC %d >= Code End %d).\n", 
+                current->pid, current->pc, code_end_index);
+        log_trace(buffer);
+        update_pcb_in_memory(current); // Update state in memory
+    } else {
+        scheduler->preempt(scheduler, current); // If not terminated or blocked
+    }
+}
+
+// Processes a CPU has to get through: those waiting and the one running,
+// which FCFS keeps at the front of its queue and is then counted there
+static int cpu_load(const cpu_t *cpu) {
+    int load = cpu->sched->queue_size(cpu->sched);
+    if (cpu->current && cpu->current->state == RUNNING &&
+        cpu->sched->queue(cpu->sched) != cpu->current) load++;
+    return load;
+}
+
+// Idle CPUs take a waiting process from the busiest CPU, if that one has
+// more than it can run by itself this tick
+static void balance_cpus() {
+    for (int i = 0; i < num_cpus; i++) {
+        cpu_t *cpu = &cpus[i];
+        if (!cpu->sched->queue_empty(cpu->sched)) continue;
+        if (cpu->current && cpu->current->state == RUNNING) continue;
+
+        cpu_t *victim = NULL;
+        int victim_load = 1;
+        for (int j = 0; j < num_cpus; j++) {
+            if (j == i) continue;
+            balance_scans++;
+            int load = cpu_load(&cpus[j]);
+            if (load > victim_load) {
+                victim = &cpus[j];
+                victim_load = load;
+            }
+        }
+        if (!victim || !victim->sched->steal) continue;
+
+        // Only waiting processes move; any other entry is a leftover
+        // duplicate of a process that runs or blocked since, and is dropped
+        pcb_t *proc = victim->sched->steal(victim->sched);
+        while (proc && proc->state != READY) proc = victim->sched->steal(victim->sched);
+        if (!proc) continue;
+        // Keep its place in time: the wait so far still counts
+        int enqueue_tick = proc->enqueue_tick;
+        cpu->sched->scheduler_enqueue(cpu->sched, proc);
+        proc->enqueue_tick = enqueue_tick;
+        cpu->steals++;
+
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "CPU %d took process %d from CPU %d\n", cpu->id, proc->pid, victim->id);
+        log_trace(buffer);
+    }
+}
+
+// CPU with the least work, where arrivals go
+static cpu_t* least_loaded_cpu() {
+    cpu_t *best = &cpus[0];
+    int best_load = -1;
+    for (int i = 0; i < num_cpus; i++) {
+        int load = cpu_load(&cpus[i]);
+        if (best_load < 0 || load < best_load) {
+            best = &cpus[i];
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+void sim_report_cpus() {
+    if (num_cpus < 2) return;
+    char buffer[256];
+    int steals = 0;
+    for (int i = 0; i < num_cpus; i++) {
+        int ticks = cpus[i].busy_ticks + cpus[i].idle_ticks;
+        snprintf(buffer, sizeof(buffer), "CPU %d: busy %d of %d ticks (%.1f%%), %d processes taken from other CPUs\n",
+                cpus[i].id, cpus[i].busy_ticks, ticks, ticks ? 100.0 * cpus[i].busy_ticks / ticks : 0.0,
+                cpus[i].steals);
+        log_message(buffer);
+        steals += cpus[i].steals;
+    }
+    snprintf(buffer, sizeof(buffer), "Load balancing: %d migrations, %d run queues inspected\n",
+            steals, balance_scans);
+    log_message(buffer);
+}
+
+// First tick from now at which an idle system can change: an arrival, a
+// deadline passing or a scheduler timer. -1 if there is none (every process
+// is blocked for good), in which case ticks are not skipped.
+static int next_event_tick() {
+    int next = ph_empty(&arrivals) ? -1 : (int) ph_top_key(&arrivals);
+    if (next >= 0 && next < clock_tick) next = clock_tick;
+    drop_finished_deadlines();
+    if (!ph_empty(&deadlines)) {
+        int at = (int) ph_top_key(&deadlines);
+        if (at < clock_tick) at = clock_tick;
+        if (next < 0 || at < next) next = at;
+    }
+    for (int i = 0; i < num_cpus; i++) {
+        Scheduler *s = cpus[i].sched;
+        int round = s->next_timer ? s->next_timer(s) : -1;
+        if (round < 0) continue;
+        int at = clock_tick + (round > sched_round ? round - sched_round : 0);
+        if (next < 0 || at < next) next = at;
+    }
+    return next;
+}
+
+// Nothing is runnable and nothing can change before the next event, so the
+// ticks until then are all idle: account for them without stepping
+static void skip_idle_ticks() {
+    int until = next_event_tick();
+    if (until > tick_limit) until = tick_limit;
+    if (until <= clock_tick) return;
+
+    // Processes already past their deadline stay past it
+    char buffer[64];
+    while (clock_tick < until) {
+        snprintf(buffer, sizeof(buffer), "\n--- Clock Tick: %d ---\n", clock_tick);
+        log_trace(buffer);
+        deadline_miss_ticks += overdue;
+        if (num_cpus > 1) balance_scans += num_cpus * (num_cpus - 1);  // every idle CPU looks at the others
+        for (int i = 0; i < num_cpus; i++) cpus[i].idle_ticks++;
+        sched_round++;
+        clock_tick++;
+    }
+}
+
+// One tick of execution, one instruction per CPU; PCB changes are only
+// mirrored to memory afterwards
+static void execute_tick() {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "\n--- Clock Tick: %d ---\n", clock_tick);
+    log_trace(buffer);
+    
+    // First check for new processes
+    load_program();
+    check_deadlines();
+    if (num_cpus > 1) balance_cpus();
+
+    int busy = 0;
+    for (int i = 0; i < num_cpus; i++) {
+        cpus[i].current = cpus[i].sched->next(cpus[i].sched);
+        if (cpus[i].current) busy++;
+    }
+    sched_round++;  // queued processes have now waited one more round
+    if (!busy) {
+        current = NULL;
+        // Check if there are any processes that are not terminated
+        int has_active_processes = 0;
+        for (pcb_t *p = proc_first(); p; p = proc_next(p)) {
+            if (p->state != TERMINATED) {
+                has_active_processes = 1;
+                break;
+            }
+        }
+        
+        if (!has_active_processes) {
+            log_message("All processes finished.\n");
+            report_turnaround();
+            report_deadlines();
+            if (scheduler->type == SCHEDULER_LOTTERY || scheduler->type == SCHEDULER_STRIDE ||
+                scheduler->type == SCHEDULER_CFS) {
+                sim_report_shares();
+            }
+            sim_report_cpus();
+            simulation_running = 0;
+        }
+        for (int i = 0; i < num_cpus; i++) cpus[i].idle_ticks++;
+        clock_tick++;  // Increment clock even when no process is running
+        if (event_driven && simulation_running) skip_idle_ticks();
+        return;
+    }
+
+    for (int i = 0; i < num_cpus; i++) {
+        if (!cpus[i].current) {
+            cpus[i].idle_ticks++;
+            continue;
+        }
+        scheduler = cpus[i].sched;  // semaphores requeue on this CPU
+        run_on_cpu(&cpus[i]);
+    }
+    scheduler = cpus[0].sched;
+    current = cpus[0].current;
+    clock_tick++;
+}
+
+void simulation_step() {
+    execute_tick();
+    flush_pcb_updates(); // One write-back per changed PCB field per tick
+}
+
+// Consume simulator options and leave the rest for the front end
+void sim_parse_options(int *argc, char *argv[]) {
+    mlfq_config_t mlfq = { MLFQ_DEFAULT_LEVELS, {0}, 0 };
+    int kept = 1;
+    for (int i = 1; i < *argc; i++) {
+        if (strncmp(argv[i], "--mem-words=", 12) == 0) {
+            int words = atoi(argv[i] + 12);
+            if (mem_set_size(words) < 0) {
+                printf("Cannot allocate a %s-word memory pool.\n", argv[i] + 12);
+                exit(1);
+            }
+        } else if (strncmp(argv[i], "--fit=", 6) == 0) {
+            const char *policy = argv[i] + 6;
+            if (strcmp(policy, "first") == 0) mem_set_fit_policy(MEM_FIRST_FIT);
+            else if (strcmp(policy, "best") == 0) mem_set_fit_policy(MEM_BEST_FIT);
+            else if (strcmp(policy, "next") == 0) mem_set_fit_policy(MEM_NEXT_FIT);
+            else printf("Unknown fit policy '%s', using first fit.\n", policy);
+        } else if (strncmp(argv[i], "--program-cache=", 16) == 0) {
+            program_cache_set_dir(argv[i] + 16);
+        } else if (strncmp(argv[i], "--mlfq-levels=", 14) == 0) {
+            mlfq.levels = atoi(argv[i] + 14);
+            if (mlfq.levels < 1 || mlfq.levels > MLFQ_MAX_LEVELS) {
+                printf("MLFQ needs 1 to %d levels.\n", MLFQ_MAX_LEVELS);
+                exit(1);
+            }
+        } else if (strncmp(argv[i], "--mlfq-quanta=", 14) == 0) {
+            // Comma-separated, from level 0 down; later levels keep doubling
+            const char *p = argv[i] + 14;
+            for (int level = 0; level < MLFQ_MAX_LEVELS && *p; level++) {
+                mlfq.quanta[level] = atoi(p);
+                p = strchr(p, ',');
+                if (!p) break;
+                p++;
+            }
+        } else if (strncmp(argv[i], "--mlfq-boost=", 13) == 0) {
+            mlfq.boost_interval = atoi(argv[i] + 13);
+        } else if (strcmp(argv[i], "--event-driven") == 0) {
+            event_driven = 1;
+        } else if (strncmp(argv[i], "--cpus=", 7) == 0) {
+            if (sim_set_cpus(atoi(argv[i] + 7)) < 0) {
+                printf("The simulator runs 1 to %d CPUs.\n", MAX_CPUS);
+                exit(1);
+            }
+        } else if (strncmp(argv[i], "--resources=", 12) == 0) {
+            if (sem_load_config(argv[i] + 12) < 0) exit(1);
+        } else if (strncmp(argv[i], "--scheduler-module=", 19) == 0) {
+            if (scheduler_load_module(argv[i] + 19) < 0) exit(1);
+        } else if (strncmp(argv[i], "--lottery-seed=", 15) == 0) {
+            lottery_set_seed(strtoul(argv[i] + 15, NULL, 10));
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    *argc = kept;
+    argv[kept] = NULL;
+    mlfq_configure(&mlfq);
+}
@@ -0,0 +1,30 @@
+// src/sjf_scheduler.c
+#include "../include/sjf_scheduler.h"
+#include "../include/keyed_heap_scheduler.h"
+
+// Instructions the process still has to run
+static long remaining(keyed_heap_t *kh, pcb_t *proc) {
+    (void) kh;
+    return proc->code_base + proc->code_len - proc->pc;
+}
+
+static const keyed_heap_policy_t sjf_policy = {
+    .name = "SJF",
+    .key = remaining,
+};
+
+// SRT: a shorter job that arrived or woke up takes over
+static const keyed_heap_policy_t srt_policy = {
+    .name = "SRT",
+    .key = remaining,
+    .preemptive = 1,
+    .key_unit = "left",
+};
+
+Scheduler* create_sjf_scheduler() {
+    return create_keyed_heap_scheduler(SCHEDULER_SJF, &sjf_policy);
+}
+
+Scheduler* create_srt_scheduler() {
+    return create_keyed_heap_scheduler(SCHEDULER_SRT, &srt_policy);
+}
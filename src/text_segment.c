@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "../include/text_segment.h"
+#include "../include/program_cache.h"
+#include "../include/memory.h"
+
+typedef struct segment {
+    char            path[MAX_LINE_LEN];
+    struct stat     st;        // source as it was when loaded
+    text_segment_t  seg;
+    int             refs;
+    int             current;   // still the one handed out for `path`
+    struct segment *next;
+} segment_t;
+
+static segment_t *segments = NULL;
+
+static int same_source(const struct stat *a, const struct stat *b) {
+    return a->st_size == b->st_size &&
+           a->st_mtim.tv_sec == b->st_mtim.tv_sec &&
+           a->st_mtim.tv_nsec == b->st_mtim.tv_nsec;
+}
+
+int text_segment_attach(const char *path, text_segment_t *seg) {
+    struct stat st;
+    if (stat(path, &st) < 0) return -1;
+
+    for (segment_t *s = segments; s; s = s->next) {
+        if (!s->current || strcmp(s->path, path) != 0) continue;
+        if (same_source(&s->st, &st)) {
+            s->refs++;
+            *seg = s->seg;
+            return 0;
+        }
+        // The file was edited: new processes get a fresh copy, running
+        // ones keep the segment they started with
+        s->current = 0;
+    }
+
+    program_t *prog = program_cache_load(path);
+    if (!prog) return -1;
+
+    segment_t *s = calloc(1, sizeof(segment_t));
+    int base = s && prog->n_code > 0 ? mem_alloc(prog->n_code) : 0;
+    if (!s || base < 0) {
+        free(s);
+        program_free(prog);
+        return -2;
+    }
+    for (int i = 0; i < prog->n_code; i++) {
+        mem_write(base + i, "instruction", (char*) program_line(prog, i));
+    }
+
+    strncpy(s->path, path, sizeof(s->path) - 1);
+    s->st = st;
+    s->seg.prog = prog;
+    s->seg.base = base;
+    s->refs = 1;
+    s->current = 1;
+    s->next = segments;
+    segments = s;
+    *seg = s->seg;
+    return 0;
+}
+
+void text_segment_detach(const program_t *prog) {
+    for (segment_t **link = &segments; *link; link = &(*link)->next) {
+        segment_t *s = *link;
+        if (s->seg.prog != prog) continue;
+        if (--s->refs == 0) {
+            if (prog->n_code > 0) mem_free(s->seg.base, prog->n_code);
+            program_free(s->seg.prog);
+            *link = s->next;
+            free(s);
+        }
+        return;
+    }
+}
+
+void text_segment_reset(void) {
+    // The memory is gone already; the compiled programs go with the records
+    while (segments) {
+        segment_t *s = segments;
+        segments = s->next;
+        program_free(s->seg.prog);
+        free(s);
+    }
+}